@@ -0,0 +1,134 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACCUMULATOR_H
+#define ACCUMULATOR_H
+
+#include <thread>
+
+#include "biginteger.h"
+
+namespace biginteger {
+
+/// Sum of many values in carry save form.
+/// Every 64 bit word counts its own carries, so adding a value has no carry chain
+/// between the words. The carries are propagated once by result(), which returns
+/// the sum in a type with one more block.
+template<big_integer T>
+class Accumulator
+{
+	static constexpr std::size_t N = T::word_count;
+	static constexpr bool is_signed = T(0u) > ~T(0u);
+
+public:
+	using result_type = widen_t<T>;
+
+	constexpr Accumulator() = default;
+
+	constexpr Accumulator & add(const T & value)
+	{
+		add_words(value.to_words());
+		return *this;
+	}
+
+	constexpr Accumulator & add(std::span<const T> values)
+	{
+		for(const auto & v : values)
+		{
+			add_words(v.to_words());
+		}
+		return *this;
+	}
+
+	/// Add a partial sum, e.g. from another thread.
+	constexpr Accumulator & merge(const Accumulator & other)
+	{
+		for(std::size_t i = 0; i < N; i++)
+		{
+			const uint64_t sum = sums[i] + other.sums[i];
+			carries[i] += other.carries[i] + (sum < sums[i]);
+			sums[i] = sum;
+		}
+		negatives += other.negatives;
+		return *this;
+	}
+
+	/// Normalized sum.
+	constexpr result_type result() const
+	{
+		std::array<uint64_t,result_type::word_count> total{}, carry{}, borrow{};
+		std::copy(sums.begin(), sums.end(), total.begin());
+		std::copy(carries.begin(), carries.end(), carry.begin() + 1);
+		detail::add_words(total, carry);
+		if constexpr(is_signed)
+		{
+			/// every negative value was added as value + 2^bit_size
+			borrow[N] = negatives;
+			detail::sub_words(total, borrow);
+		}
+		return result_type::from_words(total);
+	}
+
+	/// Sum of values, split into one partial accumulator per thread.
+	static result_type sum(std::span<const T> values, unsigned threads = std::thread::hardware_concurrency())
+	{
+		/// chunks below this size are not worth a thread
+		constexpr std::size_t min_chunk = 1 << 16;
+		const std::size_t count = std::clamp<std::size_t>(values.size() / min_chunk, 1, std::max(threads, 1u));
+		const std::size_t chunk = (values.size() + count - 1) / count;
+		auto part = [&values, chunk](std::size_t i) {
+			const std::size_t begin = std::min(i * chunk, values.size());
+			return values.subspan(begin, std::min(chunk, values.size() - begin));
+		};
+		std::vector<Accumulator> partial(count);
+		std::vector<std::thread> workers;
+		for(std::size_t i = 1; i < count; i++)
+		{
+			workers.emplace_back([&partial, &part, i] { partial[i].add(part(i)); });
+		}
+		partial[0].add(part(0));
+		for(std::size_t i = 0; i < workers.size(); i++)
+		{
+			workers[i].join();
+			partial[0].merge(partial[i + 1]);
+		}
+		return partial[0].result();
+	}
+
+private:
+	constexpr void add_words(const std::array<uint64_t,N> & words)
+	{
+		for(std::size_t i = 0; i < N; i++)
+		{
+			const uint64_t sum = sums[i] + words[i];
+			carries[i] += sum < words[i];
+			sums[i] = sum;
+		}
+		if constexpr(is_signed)
+		{
+			negatives += words[N - 1] >> 63;
+		}
+	}
+
+	std::array<uint64_t,N> sums{};
+	std::array<uint64_t,N> carries{};
+	uint64_t negatives = 0;
+};
+
+}
+
+#endif // ACCUMULATOR_H
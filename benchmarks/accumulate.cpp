@@ -0,0 +1,55 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+#include "accumulator.h"
+#include "numbertheory.h"
+
+using namespace biginteger;
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 10000000);
+	std::mt19937_64 engine(2020);
+	std::vector<uint256_t> values;
+	values.reserve(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		values.push_back(random<uint256_t>(engine) >> 64u);
+	}
+
+	benchmark::measure("uint256_t operator+=", n, [&] {
+		uint256_t sum;
+		for(const auto & v : values)
+		{
+			sum += v;
+		}
+		benchmark::do_not_optimize(sum);
+	});
+	benchmark::measure("Accumulator<uint256_t>::add", n, [&] {
+		Accumulator<uint256_t> acc;
+		acc.add(values);
+		benchmark::do_not_optimize(acc.result());
+	});
+	benchmark::measure("Accumulator<uint256_t>::sum", n, [&] {
+		benchmark::do_not_optimize(Accumulator<uint256_t>::sum(values));
+	});
+	return 0;
+}
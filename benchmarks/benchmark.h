@@ -0,0 +1,72 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace benchmark {
+
+/// Prevent the compiler from dropping a computed value
+template<typename T>
+inline void do_not_optimize(const T & value)
+{
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+/// Run f once and print the time per operation for count operations
+template<typename F>
+double measure(const char * name, std::size_t count, F && f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto stop = std::chrono::steady_clock::now();
+	double ns = std::chrono::duration<double,std::nano>(stop - start).count() / static_cast<double>(count);
+	std::printf("%-48s %10.2f ns/op\n", name, ns);
+	return ns;
+}
+
+/// Run f runs times without printing, the times per operation for count operations sorted
+template<typename F>
+std::vector<double> repeat(std::size_t runs, std::size_t count, F && f)
+{
+	std::vector<double> ns;
+	for(std::size_t i = 0; i < runs; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto stop = std::chrono::steady_clock::now();
+		ns.push_back(std::chrono::duration<double,std::nano>(stop - start).count() / static_cast<double>(count));
+	}
+	std::sort(ns.begin(), ns.end());
+	return ns;
+}
+
+/// Number of elements from the first command line argument
+inline std::size_t count_argument(int argc, char ** argv, std::size_t count)
+{
+	return argc > 1 ? std::strtoull(argv[1], nullptr, 10) : count;
+}
+
+}
+
+#endif // BENCHMARK_H
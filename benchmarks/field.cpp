@@ -0,0 +1,152 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "biginteger.h"
+#include "numbertheory.h"
+#include "primefield.h"
+
+using namespace biginteger;
+
+struct Curve25519
+{
+	static constexpr uint256_t value = (uint256_t(1u) << 255u) - 19u;
+};
+
+struct Secp256k1
+{
+	static constexpr uint256_t value = ~uint256_t(0u) - (uint256_t(1u) << 32u) - 976u;
+};
+
+struct P511
+{
+	static constexpr uint512_t value = (uint512_t(1u) << 511u) - 187u;
+};
+
+/// Chained field products, special form reduction against Montgomery and divmod
+template<typename Modulus>
+void compare(const char * name, std::size_t n)
+{
+	using F = PrimeField<Modulus>;
+	using T = typename F::value_type;
+	std::mt19937_64 engine(2020);
+	std::vector<T> a;
+	std::vector<F> f;
+	for(std::size_t i = 0; i < n; i++)
+	{
+		a.push_back(random_below(engine, F::modulus()));
+		f.push_back(F(a.back()));
+	}
+
+	F x(T(3u));
+	benchmark::measure((std::string(name) + " PrimeField mul").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			x *= f[i];
+		}
+	});
+	benchmark::measure((std::string(name) + " PrimeField sqr").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			x = x.sqr();
+		}
+	});
+	benchmark::do_not_optimize(x);
+
+	const Montgomery<T> mont(F::modulus());
+	T y = mont.one();
+	benchmark::measure((std::string(name) + " Montgomery mul").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			y = mont.mul(y, a[i]);
+		}
+	});
+	benchmark::do_not_optimize(y);
+
+	const auto wide_m = fma_wide(F::modulus(), T(1u), T(0u));
+	auto z = fma_wide(T(3u), T(1u), T(0u));
+	benchmark::measure((std::string(name) + " multiply and divmod").c_str(), n / 16, [&] {
+		for(std::size_t i = 0; i < n / 16; i++)
+		{
+			auto low = z.to_words();
+			std::array<uint64_t,T::word_count> words;
+			std::copy(low.begin(), low.begin() + T::word_count, words.begin());
+			z = fma_wide(T::from_words(words), a[i], T(0u)) % wide_m;
+		}
+	});
+	benchmark::do_not_optimize(z);
+}
+
+/// Exponentiations with one fixed base, the table is built outside the measurement
+template<typename T>
+void compare_pow(const char * name, std::size_t n)
+{
+	std::mt19937_64 engine(2020);
+	const T m = (random<T>(engine) >> 1u) | 1u;
+	const T g = random_below(engine, m);
+	const T h = random_below(engine, m);
+	std::vector<T> e, f, r(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		e.push_back(random_below(engine, m));
+		f.push_back(random_below(engine, m));
+	}
+	const FixedBasePow<T> table_g(g, m);
+	const FixedBasePow<T> table_h(h, m);
+	benchmark::measure((std::string(name) + " powmod").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			r[i] = powmod(g, e[i], m);
+		}
+	});
+	benchmark::measure((std::string(name) + " FixedBasePow").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			r[i] = table_g.pow(e[i]);
+		}
+	});
+	const std::array<T,2> bases = {g, h};
+	benchmark::measure((std::string(name) + " g^e h^f multi_powmod").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			const std::array<T,2> exponents = {e[i], f[i]};
+			r[i] = multi_powmod(std::span<const T>(bases), std::span<const T>(exponents), m);
+		}
+	});
+	benchmark::measure((std::string(name) + " g^e h^f FixedBasePow").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			r[i] = table_g.pow(e[i], table_h, f[i]);
+		}
+	});
+	benchmark::do_not_optimize(r);
+}
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 1000000);
+	compare<Curve25519>("2^255 - 19", n);
+	compare<Secp256k1>("secp256k1", n);
+	compare<P511>("2^511 - 187", n / 4);
+	compare_pow<uint256_t>("uint256_t", n / 1000);
+	compare_pow<uint1024_t>("uint1024_t", n / 10000);
+	return 0;
+}
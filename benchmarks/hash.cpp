@@ -0,0 +1,198 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "biginteger.h"
+#include "numbertheory.h"
+
+using namespace biginteger;
+
+/// Typical hand written hasher, boost::hash_combine over the words
+struct CombineHash
+{
+	std::size_t operator()(const uint256_t & n) const noexcept
+	{
+		std::size_t seed = 0;
+		for(auto w : n.to_words())
+		{
+			seed ^= std::hash<uint64_t>{}(w) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+		}
+		return seed;
+	}
+};
+
+/// Open addressing map with linear probing and power of two capacity
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatMap
+{
+public:
+	explicit FlatMap(std::size_t capacity)
+		: slots(std::bit_ceil(capacity * 2))
+		, mask(slots.size() - 1)
+	{}
+
+	void insert(const Key & key, const Value & value)
+	{
+		std::size_t i = Hash{}(key) & mask;
+		while(slots[i].used && slots[i].key != key)
+		{
+			i = (i + 1) & mask;
+		}
+		slots[i].key = Key(key);
+		slots[i].value = value;
+		slots[i].used = true;
+	}
+
+	const Value * find(const Key & key) const
+	{
+		std::size_t i = Hash{}(key) & mask;
+		while(slots[i].used)
+		{
+			if(slots[i].key == key)
+			{
+				return &slots[i].value;
+			}
+			i = (i + 1) & mask;
+		}
+		return nullptr;
+	}
+
+private:
+	struct Slot
+	{
+		Key key;
+		Value value{};
+		bool used = false;
+	};
+
+	std::vector<Slot> slots;
+	std::size_t mask;
+};
+
+template<typename Map>
+void run_map(const char * name, const std::vector<uint256_t> & keys, const std::vector<uint256_t> & misses, Map && map)
+{
+	const std::size_t n = keys.size();
+	std::string label = std::string(name) + " insert";
+	benchmark::measure(label.c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			map.insert({keys[i], static_cast<uint32_t>(i)});
+		}
+	});
+	label = std::string(name) + " lookup hit";
+	benchmark::measure(label.c_str(), n, [&] {
+		std::size_t found = 0;
+		for(const auto & k : keys)
+		{
+			found += map.find(k) != map.end();
+		}
+		benchmark::do_not_optimize(found);
+	});
+	label = std::string(name) + " lookup miss";
+	benchmark::measure(label.c_str(), n, [&] {
+		std::size_t found = 0;
+		for(const auto & k : misses)
+		{
+			found += map.find(k) != map.end();
+		}
+		benchmark::do_not_optimize(found);
+	});
+}
+
+template<typename Hash>
+void run_flat(const char * name, const std::vector<uint256_t> & keys, const std::vector<uint256_t> & misses)
+{
+	const std::size_t n = keys.size();
+	FlatMap<uint256_t,uint32_t,Hash> map(n);
+	std::string label = std::string(name) + " insert";
+	benchmark::measure(label.c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			map.insert(keys[i], static_cast<uint32_t>(i));
+		}
+	});
+	label = std::string(name) + " lookup hit";
+	benchmark::measure(label.c_str(), n, [&] {
+		std::size_t found = 0;
+		for(const auto & k : keys)
+		{
+			found += map.find(k) != nullptr;
+		}
+		benchmark::do_not_optimize(found);
+	});
+	label = std::string(name) + " lookup miss";
+	benchmark::measure(label.c_str(), n, [&] {
+		std::size_t found = 0;
+		for(const auto & k : misses)
+		{
+			found += map.find(k) != nullptr;
+		}
+		benchmark::do_not_optimize(found);
+	});
+}
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 2000000);
+	std::mt19937_64 engine(2020);
+	std::vector<uint256_t> keys, misses;
+	keys.reserve(n);
+	misses.reserve(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		/// ids with structure: a random prefix and a counter in the low word
+		keys.push_back((random<uint256_t>(engine) >> 128u << 128u) | uint256_t(i));
+		misses.push_back(random<uint256_t>(engine));
+	}
+
+	benchmark::measure("std::hash<uint256_t>", n, [&] {
+		std::size_t h = 0;
+		for(const auto & k : keys)
+		{
+			h ^= std::hash<uint256_t>{}(k);
+		}
+		benchmark::do_not_optimize(h);
+	});
+	benchmark::measure("hash_combine", n, [&] {
+		std::size_t h = 0;
+		for(const auto & k : keys)
+		{
+			h ^= CombineHash{}(k);
+		}
+		benchmark::do_not_optimize(h);
+	});
+
+	{
+		std::unordered_map<uint256_t,uint32_t> map;
+		map.reserve(n);
+		run_map("unordered_map std::hash", keys, misses, map);
+	}
+	{
+		std::unordered_map<uint256_t,uint32_t,CombineHash> map;
+		map.reserve(n);
+		run_map("unordered_map hash_combine", keys, misses, map);
+	}
+	run_flat<std::hash<uint256_t>>("flat map std::hash", keys, misses);
+	run_flat<CombineHash>("flat map hash_combine", keys, misses);
+	return 0;
+}
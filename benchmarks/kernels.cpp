@@ -0,0 +1,194 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "biginteger.h"
+#include "kernels.h"
+#include "numbertheory.h"
+
+using namespace biginteger;
+
+/// Time one word kernel over n values of Bits bits stored back to back
+template<std::size_t Bits, typename F>
+double run(const std::string & name, std::size_t n, F && kernel)
+{
+	constexpr std::size_t words = Bits / 64;
+	std::mt19937_64 engine(2020);
+	std::vector<uint64_t> a(n * words), b(n * words), r(n * words);
+	for(std::size_t i = 0; i < n * words; i++)
+	{
+		a[i] = engine();
+		b[i] = engine();
+	}
+	const double ns = benchmark::measure(name.c_str(), n, [&] {
+		for(std::size_t i = 0; i < n * words; i += words)
+		{
+			kernel(r.data() + i, a.data() + i, b.data() + i, words);
+		}
+	});
+	benchmark::do_not_optimize(r);
+	return ns;
+}
+
+/// The operator on the same values for reference
+template<std::size_t Bits, typename F>
+double run_operator(const std::string & name, std::size_t n, F && op)
+{
+	using T = BigInt<Bits,false>;
+	std::mt19937_64 engine(2020);
+	std::vector<T> a, b, c(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		a.push_back(random<T>(engine));
+		b.push_back(random<T>(engine));
+	}
+	const double ns = benchmark::measure(name.c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			c[i] = op(a[i], b[i]);
+		}
+	});
+	benchmark::do_not_optimize(c);
+	return ns;
+}
+
+template<std::size_t Bits>
+void compare_all(std::size_t n)
+{
+	const std::string prefix = std::to_string(Bits) + " bit ";
+	run_operator<Bits>(prefix + "multiply operator", n, [](const auto & a, const auto & b) { return a * b; });
+	run<Bits>(prefix + "mul_add generic", n, kernels::generic::mul_add);
+	if(kernels::cpu().bmi2 && kernels::cpu().adx)
+	{
+		run<Bits>(prefix + "mul_add adx", n, kernels::adx::mul_add);
+	}
+	run_operator<Bits>(prefix + "add operator", n, [](const auto & a, const auto & b) { return a + b; });
+	run<Bits>(prefix + "add generic", n, kernels::generic::add);
+	if(kernels::cpu().adx)
+	{
+		run<Bits>(prefix + "add adx", n, kernels::adx::add);
+	}
+	if(kernels::cpu().avx512f)
+	{
+		run<Bits>(prefix + "add avx512", n, kernels::avx512::add);
+	}
+}
+
+/// Carry-less products of Bits wide values into 2 Bits wide results
+template<std::size_t Bits, typename F>
+void run_clmul(const std::string & name, std::size_t n, F && kernel)
+{
+	constexpr std::size_t words = Bits / 64;
+	std::mt19937_64 engine(2020);
+	std::vector<uint64_t> a(n * words), b(n * words), r(2 * n * words);
+	for(std::size_t i = 0; i < n * words; i++)
+	{
+		a[i] = engine();
+		b[i] = engine();
+	}
+	benchmark::measure(name.c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			kernel(r.data() + 2 * i * words, a.data() + i * words, b.data() + i * words, words);
+		}
+	});
+	benchmark::do_not_optimize(r);
+}
+
+template<std::size_t Bits>
+void compare_clmul(std::size_t n)
+{
+	const std::string prefix = std::to_string(Bits) + " bit clmul ";
+	run_clmul<Bits>(prefix + "generic", n, kernels::generic::clmul);
+	if(kernels::cpu().pclmulqdq)
+	{
+		run_clmul<Bits>(prefix + "pclmulqdq", n, kernels::pclmul::clmul);
+	}
+}
+
+/// Montgomery products one by one and as a batch
+template<typename T>
+void compare_montgomery(const char * name, std::size_t n)
+{
+	std::mt19937_64 engine(2020);
+	const Montgomery<T> mont((random<T>(engine) >> 1u) | 1u);
+	std::vector<T> a, b, c(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		a.push_back(random_below(engine, mont.modulus()));
+		b.push_back(random_below(engine, mont.modulus()));
+	}
+	benchmark::measure((std::string(name) + " Montgomery mul").c_str(), n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			c[i] = mont.mul(a[i], b[i]);
+		}
+	});
+	benchmark::measure((std::string(name) + " Montgomery mul_many").c_str(), n, [&] { mont.mul_many(a, b, c); });
+	benchmark::do_not_optimize(c);
+}
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 200000);
+	const auto & cpu = kernels::cpu();
+	std::printf("bmi2 %d adx %d avx2 %d avx512f %d avx512ifma %d pclmulqdq %d vpclmulqdq %d\n",
+		cpu.bmi2, cpu.adx, cpu.avx2, cpu.avx512f, cpu.avx512ifma, cpu.pclmulqdq, cpu.vpclmulqdq);
+	compare_all<256>(n);
+	compare_all<512>(n);
+	compare_all<1024>(n);
+	compare_all<2048>(n / 4);
+	compare_all<4096>(n / 16);
+
+	/// batch kernels over uint512_t sized values
+	std::mt19937_64 engine(2020);
+	std::vector<uint64_t> a(n * 8), b(n * 8), r(n * 8);
+	for(std::size_t i = 0; i < n * 8; i++)
+	{
+		a[i] = engine();
+		b[i] = engine();
+	}
+	benchmark::measure("512 bit add_batch generic", n, [&] { kernels::generic::add_batch(r.data(), a.data(), b.data(), 8, n); });
+	benchmark::measure("512 bit add_batch dispatched", n, [&] { kernels::add_batch(r.data(), a.data(), b.data(), 8, n); });
+	benchmark::do_not_optimize(r);
+
+	/// three way compares of uint512_t sized values that differ only in the low word
+	b = a;
+	for(std::size_t i = 0; i < n * 8; i += 8)
+	{
+		b[i] = engine();
+	}
+	std::vector<int8_t> order(n);
+	benchmark::measure("512 bit compare_batch generic", n, [&] { kernels::generic::compare_batch(order.data(), a.data(), b.data(), 8, n, false); });
+	benchmark::measure("512 bit compare_batch dispatched", n, [&] { kernels::compare_batch(order.data(), a.data(), b.data(), 8, n, false); });
+	benchmark::do_not_optimize(order);
+
+	compare_clmul<128>(n);
+	compare_clmul<256>(n);
+	compare_clmul<512>(n);
+	compare_clmul<1024>(n / 4);
+
+	compare_montgomery<uint256_t>("uint256_t", n);
+	compare_montgomery<uint512_t>("uint512_t", n);
+	compare_montgomery<uint1024_t>("uint1024_t", n / 4);
+	compare_montgomery<uint2048_t>("uint2048_t", n / 16);
+	return 0;
+}
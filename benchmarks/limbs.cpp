@@ -0,0 +1,113 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "biginteger.h"
+#include "numbertheory.h"
+
+using namespace biginteger;
+
+/// Repetitions per cell, the medians and quartiles decide
+constexpr std::size_t runs = 9;
+
+/// Smallest gain of the median for which 64 bit limbs are chosen
+constexpr double min_gain = 0.1;
+
+/// Sorted times of one operation over n value pairs
+template<typename T, typename F>
+std::vector<double> run(std::size_t n, F && op)
+{
+	std::mt19937_64 engine(2020);
+	std::vector<T> a, b, c(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		a.push_back(random<T>(engine));
+		b.push_back(random<T>(engine) >> (T::bit_size / 2));
+	}
+	const std::vector<double> ns = benchmark::repeat(runs, n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			c[i] = op(a[i], b[i]);
+		}
+	});
+	benchmark::do_not_optimize(c);
+	return ns;
+}
+
+/// Compare the default 128 bit limbs with 64 bit limbs for one operation. 64 bit limbs only
+/// win if their median is min_gain faster and their upper quartile is below the lower
+/// quartile of the 128 bit limbs, otherwise the difference is run to run noise.
+template<std::size_t Bits, typename F>
+bool compare(const char * operation, std::size_t n, F && op)
+{
+	using Wide = BigInt<Bits,false,__uint128_t>;
+	using Narrow = BigInt<Bits,false,uint64_t>;
+	const std::vector<double> wide = run<Wide>(n, op);
+	const std::vector<double> narrow = run<Narrow>(n, op);
+	const auto median = [](const std::vector<double> & ns) { return ns[ns.size() / 2]; };
+	const bool faster = median(narrow) < (1 - min_gain) * median(wide) && narrow[3 * runs / 4] < wide[runs / 4];
+	const std::string name = "uint" + std::to_string(Bits) + "_t " + operation;
+	std::printf("%-28s 128 bit %10.2f ns  64 bit %10.2f ns  %s\n", name.c_str(), median(wide), median(narrow),
+		faster ? "uint64_t" : "__uint128_t");
+	return faster;
+}
+
+template<std::size_t Bits>
+std::string compare_all(std::size_t n)
+{
+	const bool add = compare<Bits>("add", n, [](const auto & a, const auto & b) { return a + b; });
+	const bool multiply = compare<Bits>("multiply", n, [](const auto & a, const auto & b) { return a * b; });
+	const bool divide = compare<Bits>("divide", n / 16, [](const auto & a, const auto & b) { return a / b; });
+	const bool shift = compare<Bits>("shift", n, [](const auto & a, const auto & b) { return (a << 37u) ^ (b >> 71u); });
+	char row[64];
+	std::snprintf(row, sizeof(row), "\t{%-6s %-6s %-6s %s},\n", add ? "true," : "false,", multiply ? "true," : "false,",
+		divide ? "true," : "false,", shift ? "true" : "false");
+	return row;
+}
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 200000);
+	std::string table = compare_all<256>(n);
+	table += compare_all<512>(n);
+	table += compare_all<1024>(n);
+	table += compare_all<2048>(n / 4);
+	table += compare_all<4096>(n / 16);
+	std::printf("\ndetail::limb64_faster for this machine:\n%s\n", table.c_str());
+
+	/// layout conversion should cost a copy
+	std::mt19937_64 engine(2020);
+	std::vector<uint512_t> a;
+	std::vector<uint512_64_t> b(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		a.push_back(random<uint512_t>(engine));
+	}
+	benchmark::measure("uint512_t to uint512_64_t", n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			b[i] = limb_cast<uint512_64_t>(a[i]);
+		}
+	});
+	benchmark::do_not_optimize(b);
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "biginteger.h"
+#include "numberfile.h"
+
+using namespace biginteger;
+
+/// Text of n lines "index,value" with random 256 bit values in decimal or hex
+std::string make_text(std::size_t n, bool hex)
+{
+	std::mt19937_64 engine(2020);
+	std::string text;
+	char digits[24];
+	for(std::size_t i = 0; i < n; i++)
+	{
+		text += std::to_string(i) + (hex ? ",0x" : ",");
+		if(hex)
+		{
+			for(std::size_t w = 4; w-- > 0;)
+			{
+				std::snprintf(digits, sizeof(digits), "%016llx", static_cast<unsigned long long>(engine()));
+				text += digits;
+			}
+		}
+		else
+		{
+			/// 77 digits stay below 2^256
+			for(std::size_t d = 0; d < 7; d++)
+			{
+				std::snprintf(digits, sizeof(digits), "%011llu", static_cast<unsigned long long>(engine() % 100000000000u));
+				text += digits;
+			}
+		}
+		text += '\n';
+	}
+	return text;
+}
+
+void compare(const char * name, const std::string & text, std::size_t n)
+{
+	NumberFileOptions options;
+	options.column = 1;
+	std::vector<unsigned> counts{1};
+	if(std::thread::hardware_concurrency() > 1)
+	{
+		counts.push_back(std::thread::hardware_concurrency());
+	}
+	for(const unsigned threads : counts)
+	{
+		options.threads = threads;
+		NumberFile<uint256_t> result;
+		const double ns = benchmark::measure((std::string(name) + " " + std::to_string(threads) + " threads").c_str(), n, [&] {
+			result = parse_numbers<uint256_t>(text, options);
+		});
+		std::printf("%-48s %10.2f MB/s\n", "", 1000.0 * static_cast<double>(text.size()) / (ns * static_cast<double>(n)));
+		if(result.values.size() != n || !result.malformed.empty())
+		{
+			std::printf("parse error\n");
+		}
+	}
+}
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 4000000);
+	compare("decimal uint256_t", make_text(n, false), n);
+	compare("hex uint256_t", make_text(n, true), n);
+	return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+#include "rnsinteger.h"
+#include "numbertheory.h"
+
+using namespace biginteger;
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 100000);
+	using Rns = RnsInteger<uint1024_t>;
+	std::mt19937_64 engine(2020);
+	const uint1024_t m = random<uint1024_t>(engine) | 1u;
+	const Montgomery<uint1024_t> mont(m);
+	std::vector<uint1024_t> a, b, c(n);
+	std::vector<Rns> ra, rb, rc(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		a.push_back(random<uint1024_t>(engine) % m);
+		b.push_back(random<uint1024_t>(engine) % m);
+		ra.emplace_back(a.back());
+		rb.emplace_back(b.back());
+	}
+
+	benchmark::measure("uint1024_t operator*", n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			c[i] = a[i] * b[i];
+		}
+	});
+	benchmark::measure("Montgomery<uint1024_t>::mul", n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			c[i] = mont.mul(a[i], b[i]);
+		}
+	});
+	benchmark::measure("RnsInteger<uint1024_t> operator*", n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			rc[i] = ra[i] * rb[i];
+		}
+	});
+	benchmark::measure("RnsInteger<uint1024_t> from uint1024_t", n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			rc[i] = Rns(a[i]);
+		}
+	});
+	benchmark::measure("RnsInteger<uint1024_t> to uint1024_t", n, [&] {
+		for(std::size_t i = 0; i < n; i++)
+		{
+			c[i] = rc[i].to_integer();
+		}
+	});
+	benchmark::do_not_optimize(c);
+	benchmark::do_not_optimize(rc);
+	return 0;
+}
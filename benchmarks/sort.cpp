@@ -0,0 +1,70 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "biginteger.h"
+#include "numbertheory.h"
+
+using namespace biginteger;
+
+template<typename T>
+void run(const char * name, std::size_t n)
+{
+	std::mt19937_64 engine(2020);
+	std::vector<T> values, copy(n);
+	values.reserve(n);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		values.push_back(random<T>(engine) >> 16u);
+	}
+	auto reset = [&] { std::copy(values.begin(), values.end(), copy.begin()); };
+
+	reset();
+	std::string label = std::string(name) + " std::sort";
+	benchmark::measure(label.c_str(), n, [&] { std::sort(copy.begin(), copy.end()); });
+	reset();
+	label = std::string(name) + " radix sort";
+	benchmark::measure(label.c_str(), n, [&] { sort(std::span(copy)); });
+
+	std::vector<int8_t> out(n);
+	label = std::string(name) + " compare_many";
+	benchmark::measure(label.c_str(), n, [&] { compare_many(std::span(values), std::span(copy), std::span(out)); });
+	benchmark::do_not_optimize(out);
+	label = std::string(name) + " lower_bound";
+	benchmark::measure(label.c_str(), n, [&] {
+		const std::span<const T> sorted(copy);
+		std::size_t sum = 0;
+		for(const auto & v : values)
+		{
+			sum += lower_bound(sorted, v) - sorted.begin();
+		}
+		benchmark::do_not_optimize(sum);
+	});
+}
+
+int main(int argc, char ** argv)
+{
+	const std::size_t n = benchmark::count_argument(argc, argv, 2000000);
+	run<uint256_t>("uint256_t", n);
+	run<int512_t>("int512_t", n);
+	run<uint1024_t>("uint1024_t", n / 4);
+	return 0;
+}
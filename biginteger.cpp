@@ -0,0 +1,31 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// Explicit instantiations of the standard types, see the extern template declarations in biginteger.h
+
+#include "biginteger.h"
+
+namespace biginteger {
+
+template class BigInteger<uint64_t,false,0,1>;
+template class BigInteger<__uint128_t,false,0,1>;
+template class BigInteger<__uint128_t,false,0,1,2,3>;
+template class BigInteger<__uint128_t,true,0,1,2,3>;
+template class BigInteger<__uint128_t,false,0,1,2,3,4,5,6,7>;
+
+}
@@ -19,26 +19,39 @@
 #define BIGINTEGER_H
 
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
-#include <sstream>
+#include <limits>
 #include <stdexcept>
 #include <concepts>
+#include <compare>
 #include <utility>
+#include <algorithm>
 #include <array>
-#include <functional>
-#include <iomanip>
-#include <iostream>
+#include <bit>
+#include <span>
+#include <vector>
+/// also declares std::hash
+#include <system_error>
+
+#ifndef BIGINTEGER_HEADER_ONLY
+#include "kernels.h"
+#endif
 
 namespace biginteger {
 
-inline std::ostream & operator<<(std::ostream & stream, const __uint128_t & r)
+namespace detail {
+
+/// Throws std::invalid_argument, aborts in builds without exceptions
+[[noreturn]] inline void invalid_argument(const char * what)
 {
-	uint64_t l = static_cast<uint64_t>(r);
-	uint64_t u = r>>64;
-	if(u > 0)
-		return stream<<std::showbase<<u<<std::noshowbase<<std::setfill('0')<<std::setw(16)<<l<<std::showbase;
-	else
-		return stream<<std::showbase<<l;
+#if defined(__cpp_exceptions)
+	throw std::invalid_argument(what);
+#else
+	(void)what;
+	std::abort();
+#endif
+}
 
 }
 
@@ -46,7 +59,7 @@ template<std::unsigned_integral B, bool is_signed, std::size_t ...I>
 class BigInteger
 {
 
-	friend class BigInteger<B,!is_signed,I...>;
+	template<std::unsigned_integral, bool, std::size_t ...> friend class BigInteger;
 
 public:
 	/// Constructors
@@ -65,7 +78,7 @@ public:
 		if(n < 0)
 		{
 			std::fill(numbers.begin(),numbers.end(),std::numeric_limits<B>::max());
-			numbers[0] -= (n + 1);
+			numbers[0] = static_cast<B>(n);
 		}
 		else
 		{
@@ -83,8 +96,36 @@ public:
 		: numbers(std::forward<decltype(n.numbers)>(n.numbers))
 	{}
 
+	/// Convert block layout of the same width, the bytes are identical on little endian
+	/// targets so this is a plain copy at run time
+	template<std::unsigned_integral B2, std::size_t ...J>
+		requires (!std::is_same_v<B2,B> && sizeof (B2) * sizeof... (J) == sizeof (B) * sizeof... (I))
+	constexpr explicit BigInteger(const BigInteger<B2,is_signed,J...> & n)
+	{
+		if(!std::is_constant_evaluated() && std::endian::native == std::endian::little)
+		{
+			std::memcpy(numbers.data(), n.numbers.data(), sizeof (numbers));
+		}
+		else if constexpr(sizeof (B2) < sizeof (B))
+		{
+			constexpr std::size_t ratio = sizeof (B) / sizeof (B2);
+			for(std::size_t i = 0; i < sizeof... (J); i++)
+			{
+				numbers[i / ratio] |= static_cast<B>(n.numbers[i]) << ((i % ratio) * std::numeric_limits<B2>::digits);
+			}
+		}
+		else
+		{
+			constexpr std::size_t ratio = sizeof (B2) / sizeof (B);
+			for(std::size_t i = 0; i < sizeof... (I); i++)
+			{
+				numbers[i] = static_cast<B>(n.numbers[i / ratio] >> ((i % ratio) * std::numeric_limits<B>::digits));
+			}
+		}
+	}
+
 	/// Assignment Operators
-	BigInteger & operator=(const BigInteger & n) = delete;
+	constexpr BigInteger & operator=(const BigInteger & n) = default;
 	constexpr BigInteger & operator=(BigInteger && n) = default;
 
 protected:
@@ -155,20 +196,29 @@ public:
 		return ((l.numbers[I] == r.numbers[I]) && ...);
 	}
 
-	/// Three way compare
+	/// Three way compare, decided by the most significant differing block
 	friend inline constexpr std::strong_ordering operator<=>(const BigInteger & l, const BigInteger & r)
 	{
-		auto ret = std::strong_ordering::equal;
-		if constexpr(is_signed)
+		constexpr std::size_t top = sizeof... (I) - 1;
+		if(l.numbers[top] != r.numbers[top])
 		{
-			((ret = (std::strong_ordering::equal != l.numbers[I] <=> r.numbers[I]) ?
-					(I + 1 < sizeof...(I) ? l.numbers[I] <=> r.numbers[I] : std::make_signed_t<B>(l.numbers[I]) <=> std::make_signed_t<B>(r.numbers[I])) : ret), ...);
+			if constexpr(is_signed)
+			{
+				return std::make_signed_t<B>(l.numbers[top]) <=> std::make_signed_t<B>(r.numbers[top]);
+			}
+			else
+			{
+				return l.numbers[top] <=> r.numbers[top];
+			}
 		}
-		else
+		for(std::size_t i = top; i-- > 0;)
 		{
-			((ret = (std::strong_ordering::equal != l.numbers[I] <=> r.numbers[I]) ? l.numbers[I] <=> r.numbers[I] : ret), ...);
+			if(l.numbers[i] != r.numbers[i])
+			{
+				return l.numbers[i] <=> r.numbers[i];
+			}
 		}
-		return ret;
+		return std::strong_ordering::equal;
 	}
 
 	/// Arithmetic Operators
@@ -176,13 +226,7 @@ public:
 	/// Plus
 	friend inline constexpr BigInteger operator+(const BigInteger & l, const BigInteger & r)
 	{
-		BigInteger sum{{(std::get<I>(l.numbers) + std::get<I>(r.numbers))...}};
-		BigInteger carry{{(sum.numbers[I] < l.numbers[I])...}};
-		auto temp = sum;
-		((std::get<I>(sum.numbers) += I > 0  ? carry.numbers[I-1] : 0), ...);
-		BigInteger carry1{{(sum.numbers[I] < temp.numbers[I])...}};
-		((std::get<I>(sum.numbers) += I > 0 ? carry1.numbers[I-1] : 0), ...);
-		return sum;
+		return add_overflow(l, r).first;
 	}
 
 	friend inline constexpr BigInteger & operator+=(BigInteger & l, const BigInteger & r)
@@ -193,13 +237,7 @@ public:
 	/// Minus
 	friend constexpr inline BigInteger operator-(const BigInteger & l, const BigInteger & r)
 	{
-		BigInteger diff{{(std::get<I>(l.numbers) - std::get<I>(r.numbers))...}};
-		BigInteger carry{{(diff.numbers[I] > l.numbers[I])...}};
-		auto temp = diff;
-		((std::get<I>(diff.numbers) -= I > 0 ? carry.numbers[I-1] : 0), ...);
-		BigInteger carry1{{(diff.numbers[I] > temp.numbers[I])...}};
-		((std::get<I>(diff.numbers) -= I > 0 ? carry1.numbers[I-1] : 0), ...);
-		return diff;
+		return sub_overflow(l, r).first;
 	}
 
 
@@ -210,74 +248,7 @@ public:
 	/// Multiply
 	friend inline constexpr BigInteger operator*(const BigInteger & l, const BigInteger & r)
 	{
-		BigInteger result;
-		std::array<B,sizeof... (I)*2> temp_l,temp_r;
-		std::array<std::array<B,sizeof... (I)*2>,sizeof... (I)*2> product;
-		constexpr auto num_bits = std::numeric_limits<B>::digits;
-		constexpr auto num_bits_half = num_bits >> 1;
-		constexpr B mask = std::numeric_limits<B>::max()>>num_bits_half;
-		for(std::size_t i = 0; i < sizeof... (I); i++)
-		{
-			std::size_t ii = i<<1;
-			temp_l[ii]   = l.numbers[i] & mask;
-			temp_l[ii+1] = l.numbers[i]>>num_bits_half;
-			temp_r[ii]   = r.numbers[i] & mask;
-			temp_r[ii+1] = r.numbers[i]>>num_bits_half;
-		}
-		for(std::size_t i = 0; i < temp_l.size(); i++)
-		{
-			for(std::size_t j = 0; j < temp_r.size(); j++)
-			{
-				product[i][j] = temp_l[i]*temp_r[j];
-			}
-		}
-		for(std::size_t jj = 0; jj < temp_l.size(); jj++)
-		{
-			for(std::size_t ii = 0; ii + jj < temp_r.size(); ii++)
-			{
-				auto j = jj>>1;
-				auto i = ii>>1;
-				auto temp0 = result.numbers[i+j];
-				decltype (temp0) temp1 = 0;
-				if((i+j) < result.numbers.size() - 1)
-				{
-					temp1 = result.numbers[i+j+1];
-				}
-
-				if(jj & 1 && ii & 1 && (i + j) < result.numbers.size() - 1)
-				{
-					result.numbers[i+j+1] += product[ii][jj];
-				}
-				else if((jj & 1 || ii & 1) && (i + j) < result.numbers.size() - 1)
-				{
-					result.numbers[i+j] += product[ii][jj] << num_bits_half;
-					result.numbers[i+j+1] += product[ii][jj] >> num_bits_half;
-				}
-				else if((jj & 1 || ii & 1) && (i + j) < result.numbers.size() )
-				{
-					result.numbers[i+j] += (product[ii][jj] & mask) << num_bits_half;
-				}
-				else
-				{
-					result.numbers[i+j] += product[ii][jj];
-				}
-
-				if((i+j) < result.numbers.size() - 2 && temp1 > result.numbers[i+j+1])
-				{
-					result.numbers[i+j+2] += 1;
-				}
-				if((i+j) < result.numbers.size() - 1 && temp0 > result.numbers[i+j])
-				{
-					temp1 = result.numbers[i+j+1];
-					result.numbers[i+j+1] += 1;
-					if((i+j) < result.numbers.size() - 2 && temp1 > result.numbers[i+j+1])
-					{
-						result.numbers[i+j+2] += 1;
-					}
-				}
-			}
-		}
-		return result;
+		return mul_add(l, r, BigInteger());
 	}
 
 	friend inline constexpr BigInteger & operator*=(BigInteger & l, const BigInteger & r){
@@ -286,7 +257,12 @@ public:
 
 	/// Divide
 	friend inline constexpr BigInteger operator/(const BigInteger & l, const BigInteger & r){
-		return divmod(l,r).first;
+		BigInteger q, rem;
+		if(divmod(l, r, q, rem) != std::errc())
+		{
+			detail::invalid_argument("Devide with zero!");
+		}
+		return q;
 	}
 
 	friend inline constexpr BigInteger & operator/=(BigInteger & l, const BigInteger & r){
@@ -295,7 +271,12 @@ public:
 
 	/// Modulo
 	friend inline constexpr BigInteger operator%(const BigInteger & l, const BigInteger & r){
-		return divmod(l,r).second;
+		BigInteger q, rem;
+		if(divmod(l, r, q, rem) != std::errc())
+		{
+			detail::invalid_argument("Devide with zero!");
+		}
+		return rem;
 	}
 
 	friend inline constexpr BigInteger & operator%=(BigInteger & l, const BigInteger & r){
@@ -335,26 +316,27 @@ public:
 		return l = l << r;
 	}
 
-	/// Shift right
+	/// Shift right, arithmetic for signed types: the vacated bits are copies of the sign bit
 	template <std::unsigned_integral T2>
 	friend inline constexpr BigInteger operator>>(const BigInteger & l, const T2 & r)
 	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		constexpr std::size_t size = sizeof... (I);
 		BigInteger result;
-		std::size_t msb = (sizeof(sizeof (B))<<3) - __builtin_clzl(sizeof (B)) - 1;
-		std::size_t chunk_shift = r>>(3+msb);
-		std::size_t left = r - ((chunk_shift*sizeof (B))<<3);
-		for(std::size_t i = chunk_shift; i < result.numbers.size(); i++)
-		{
-			result.numbers[i-chunk_shift] = l.numbers[i];
-		}
-		if(left) // 0...sizeof(B)*8 bit shift is left
+		const B fill = l.negative() ? std::numeric_limits<B>::max() : B(0);
+		const std::size_t chunk_shift = r < bit_size ? std::size_t(r / num_bits) : size;
+		const std::size_t left = r % num_bits;
+		for(std::size_t i = 0; i < size; i++)
 		{
-			result.numbers[l.numbers.size() - chunk_shift - 1] >>= left;
-			std::size_t left_shift = (sizeof (B)<<3)-left;
-			for(std::size_t i = 0; i < l.numbers.size() - chunk_shift - 1; i++)
+			const B lo = i + chunk_shift < size ? l.numbers[i + chunk_shift] : fill;
+			if(left) // 0...sizeof(B)*8 bit shift is left
+			{
+				const B hi = i + chunk_shift + 1 < size ? l.numbers[i + chunk_shift + 1] : fill;
+				result.numbers[i] = (lo >> left) | (hi << (num_bits - left));
+			}
+			else
 			{
-				result.numbers[i] >>= left;
-				result.numbers[i] |= l.numbers[i + chunk_shift + 1] << left_shift;
+				result.numbers[i] = lo;
 			}
 		}
 		return result;
@@ -399,72 +381,83 @@ public:
 	}
 
 	/// positive sign operator
-	friend BigInteger operator+(const BigInteger & hs)
+	friend constexpr BigInteger operator+(const BigInteger & hs)
 	{
 		return hs;
 	}
 
 	/// negative sign operator
-	friend BigInteger operator-(const BigInteger & hs)
+	friend constexpr BigInteger operator-(const BigInteger & hs)
 	{
-		static constexpr BigInteger uint256_1(1);
-		return ~hs + uint256_1;
+		return ~hs + 1u;
 	}
 
-	/// IO Operators
-	friend std::ostream & operator<<(std::ostream & stream, const BigInteger & r)
+	/// Blocks, least significant first
+	constexpr const std::array<B,sizeof... (I)> & blocks() const noexcept
 	{
-		return (stream<<"[ ",((stream << std::hex << (r.numbers[I]) << (I < r.numbers.size()-1 ? ", ":" ")), ...),stream<<"]");
+		return numbers;
 	}
 
 	/// Get order of msb bit.
 	/// Return [0 ... ((sizeof(block) * #block * 8) - 1)].
 	static constexpr auto bits(const BigInteger& n) {
-		constexpr auto bits_per_block = sizeof (B) * 8;
-		std::size_t out = bits_per_block * n.numbers.size();
-		auto it = n.numbers.rbegin();
-		while (it != n.numbers.rend())
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		std::size_t out = 0;
+		for(std::size_t i = 0; i < sizeof... (I); i++)
 		{
-			if(*it > 0)
-			{
-				if constexpr(sizeof (B) == 2 * sizeof (uint64_t))
-				{
-					if(B n = *it >> (sizeof (uint64_t)<<3); n > 0)
-					{
-						out -= static_cast<std::size_t>(__builtin_clzll(n));
-					}
-					else
-					{
-						out -= 64;
-						out -= static_cast<std::size_t>(__builtin_clzll(*it));
-					}
-				}
-				else if constexpr(sizeof (B) == sizeof (uint64_t))
-				{
-					out -= static_cast<std::size_t>(__builtin_clzll(*it));
-				}
-				else if constexpr(sizeof (B) == sizeof (uint32_t))
-				{
-					out -= static_cast<std::size_t>(__builtin_clz(*it));
-				}
-				else
-				{
-					static_assert(sizeof (B) == 0, "Unsupported type");
-				}
-				break;
-			}
-			else
-			{
-				out -= bits_per_block;
-			}
-			it++;
+			out = n.numbers[i] ? i * num_bits + num_bits - 1 - countl_zero_block(n.numbers[i]) : out;
 		}
-		return out > 0 ? out - 1 : 0;
+		return out;
+	}
+
+	/// Single bit access, bit in [0, bit_size)
+
+	constexpr bool test(std::size_t bit) const
+	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		return (numbers[bit / num_bits] >> (bit % num_bits)) & 1u;
+	}
+
+	constexpr BigInteger & set(std::size_t bit, bool value = true)
+	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		B & block = numbers[bit / num_bits];
+		block = (block & ~(B(1) << (bit % num_bits))) | (B(value) << (bit % num_bits));
+		return *this;
+	}
+
+	constexpr BigInteger & reset(std::size_t bit)
+	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		numbers[bit / num_bits] &= ~(B(1) << (bit % num_bits));
+		return *this;
+	}
+
+	constexpr BigInteger & flip(std::size_t bit)
+	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		numbers[bit / num_bits] ^= B(1) << (bit % num_bits);
+		return *this;
+	}
+
+	/// Get len bits starting at bit lo as native integer, bits above bit_size read as 0.
+	/// len is clamped to the width of T.
+	template<std::unsigned_integral T = uint64_t>
+	constexpr T extract(std::size_t lo, std::size_t len = std::numeric_limits<T>::digits) const
+	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		len = std::min<std::size_t>(len, std::numeric_limits<T>::digits);
+		T result = 0;
+		for(std::size_t pos = 0; pos < len && lo + pos < bit_size; pos += num_bits - (lo + pos) % num_bits)
+		{
+			result |= static_cast<T>(numbers[(lo + pos) / num_bits] >> ((lo + pos) % num_bits)) << pos;
+		}
+		return len < std::numeric_limits<T>::digits ? result & ((T(1) << len) - 1) : result;
 	}
 
 	static consteval BigInteger max() noexcept
 	{
-		BigInteger max({(I,std::numeric_limits<B>::max())...});
+		BigInteger max({((void)I,std::numeric_limits<B>::max())...});
 		if constexpr(is_signed)
 		{
 			// clear msb bit
@@ -490,134 +483,1265 @@ public:
 		return exp_by_squaring(1u, std::forward<BigInteger>(x), n);
 	}
 
-	template<char ...digits>
-	static constexpr BigInteger to_number() noexcept
+	/// Quotient and remainder, signed types truncate toward zero and the remainder
+	/// takes the sign of l. Returns std::errc::invalid_argument for r == 0, q and rem
+	/// may alias l or r.
+	static constexpr std::errc divmod(const BigInteger & l, const BigInteger & r, BigInteger & q, BigInteger & rem) noexcept
 	{
-		constexpr std::array<char, sizeof...(digits)> digits_array{ digits... };
-		constexpr bool is_hex = sizeof... (digits) > 2 && sizeof... (digits) <= ((bit_size>>2)+2) && digits_array[0] == '0' && digits_array[1] == 'x';
-		constexpr bool is_oct = sizeof... (digits) > 1 && sizeof... (digits) <= (bit_size/3+1) && digits_array[0] == '0' &&
-				(('0' <= digits && digits <= '7') && ...);
-		constexpr bool is_dec = sizeof... (digits) > 0 && sizeof... (digits) <= (static_cast<float>(bit_size)/3.32f) &&
-				(('0' <= digits && digits <= '9') && ...);
-		static_assert(is_hex || is_oct || is_dec, "invalid digit in number");
-		if constexpr(is_hex)
+		if constexpr(is_signed)
 		{
-			// remove hex 0x
-			return stoi<2>(std::forward<decltype (digits_array)>(digits_array),16u);
+			using Magnitude = BigInteger<B,false,I...>;
+			const bool negative_l = l.negative();
+			const bool negative_r = r.negative();
+			Magnitude mq, mrem;
+			const std::errc error = Magnitude::divmod(negative_l ? -l : l, negative_r ? -r : r, mq, mrem);
+			q.numbers = mq.numbers;
+			rem.numbers = mrem.numbers;
+			if(negative_l != negative_r)
+			{
+				q = -q;
+			}
+			if(negative_l)
+			{
+				rem = -rem;
+			}
+			return error;
 		}
-		else if constexpr(is_oct)
+		else
 		{
-			// remove oct 0
-			return stoi<1>(std::forward<decltype (digits_array)>(digits_array),8u);
+			return divmod_unsigned(l, r, q, rem);
 		}
-		else if constexpr(is_dec)
+	}
+
+	/// Quotient and remainder as pair, throws std::invalid_argument for r == 0
+	static constexpr std::pair<BigInteger,BigInteger> divmod(const BigInteger & l, const BigInteger & r)
+	{
+		std::pair<BigInteger,BigInteger> result;
+		if(divmod(l, r, result.first, result.second) != std::errc())
 		{
-			return stoi<0>(std::forward<decltype (digits_array)>(digits_array),10u);
+			detail::invalid_argument("Devide with zero!");
 		}
+		return result;
 	}
 
-	static constexpr std::size_t bit_size = sizeof(B) * sizeof... (I) * 8;
+	/// Overflow reporting kernels, the flag is true if the exact result does not fit.
+	/// Unsigned types report the final carry or borrow, signed types a change of sign
+	/// that the operands do not explain.
 
-private:
-	template<std::unsigned_integral T>
-	static constexpr BigInteger exp_by_squaring(BigInteger&& y, BigInteger&& x, T n)
+	static constexpr std::pair<BigInteger,bool> add_overflow(const BigInteger & l, const BigInteger & r)
 	{
-		if(n == 0)
-			return std::forward<BigInteger>(y);
-		else if(n == 1)
-			return x * y;
-		else if(n & 1) // odd
-			return exp_by_squaring( x * y, x * x, (n - 1)>>1);
-		else // even
-			return exp_by_squaring( std::forward<BigInteger>(y), x * x, n>>1);
+		BigInteger sum;
+		B carry = 0;
+		for(std::size_t i = 0; i < sizeof... (I); i++)
+		{
+			B temp = l.numbers[i] + carry;
+			carry = temp < carry;
+			sum.numbers[i] = temp + r.numbers[i];
+			carry |= sum.numbers[i] < temp;
+		}
+		if constexpr(is_signed)
+		{
+			return {sum, l.negative() == r.negative() && sum.negative() != l.negative()};
+		}
+		else
+		{
+			return {sum, carry != 0};
+		}
 	}
 
-	template<std::size_t index, std::size_t size>
-	static constexpr BigInteger stoi_impl(const std::array<char,size>&& str, BigInteger&& base, BigInteger&& value)
+	static constexpr std::pair<BigInteger,bool> sub_overflow(const BigInteger & l, const BigInteger & r)
 	{
-		auto c = str[index];
-		B i = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c - 'A' + 10;
-		if constexpr(index < size - 1)
+		BigInteger diff;
+		B borrow = 0;
+		for(std::size_t i = 0; i < sizeof... (I); i++)
+		{
+			B temp = l.numbers[i] - borrow;
+			borrow = temp > l.numbers[i];
+			diff.numbers[i] = temp - r.numbers[i];
+			borrow |= diff.numbers[i] > temp;
+		}
+		if constexpr(is_signed)
 		{
-			return stoi_impl<index+1>(std::forward<decltype (str)>(str), std::forward<BigInteger>(base), value * base + i);
+			return {diff, l.negative() != r.negative() && diff.negative() != l.negative()};
 		}
 		else
 		{
-			return value * base + i;
+			return {diff, borrow != 0};
 		}
 	}
 
-	template<std::size_t index, std::size_t size>
-	static constexpr BigInteger stoi(const std::array<char,size>&& str, BigInteger && base)
+	/// Products of blocks above the top column and carries out of it mark the overflow,
+	/// signed types multiply the magnitudes
+	static constexpr std::pair<BigInteger,bool> mul_overflow(const BigInteger & l, const BigInteger & r)
 	{
-		return stoi_impl<index>(std::forward<decltype (str)>(str), std::forward<BigInteger>(base), 0u);
+		constexpr std::size_t N = sizeof... (I);
+		if constexpr(is_signed)
+		{
+			using Magnitude = BigInteger<B,false,I...>;
+			const bool negative = l.negative() != r.negative();
+			auto [product, overflow] = Magnitude::mul_overflow(l.negative() ? -l : l, r.negative() ? -r : r);
+			/// the magnitude limit is max() + 1 for negative results
+			overflow |= product > Magnitude(max()) + Magnitude(unsigned(negative));
+			return {negative ? -BigInteger(product) : BigInteger(product), overflow};
+		}
+		else
+		{
+			BigInteger result;
+			bool overflow = false;
+			for(std::size_t i = 0; i < N; i++)
+			{
+				B carry = 0;
+				for(std::size_t j = 0; j < N; j++)
+				{
+					if(i + j < N)
+					{
+						auto [lo, hi] = mul_wide(l.numbers[i], r.numbers[j]);
+						B & sum = result.numbers[i+j];
+						sum += lo;
+						hi += sum < lo;
+						sum += carry;
+						hi += sum < carry;
+						carry = hi;
+					}
+					else
+					{
+						overflow |= l.numbers[i] != 0 && r.numbers[j] != 0;
+					}
+				}
+				overflow |= carry != 0;
+			}
+			return {result, overflow};
+		}
 	}
 
-	static constexpr std::pair<BigInteger,BigInteger> divmod(const BigInteger & l, const BigInteger & r)
+	/// Fused kernels, one pass over the blocks
+
+	/// l * r + a, the addend is the start value of the product columns
+	static constexpr BigInteger mul_add(const BigInteger & l, const BigInteger & r, const BigInteger & a)
 	{
-		BigInteger one(1u);
-		BigInteger zero(0u);
-		auto msb_r = bits(r);
-		if(r == zero)
+		BigInteger result = a;
+#ifndef BIGINTEGER_HEADER_ONLY
+		if constexpr(kernel_layout && word_count >= kernels::mul_add_words)
 		{
-			throw std::invalid_argument("Devide with zero!");
+			if(!std::is_constant_evaluated())
+			{
+				std::array<uint64_t,word_count> lw, rw, sum;
+				std::memcpy(lw.data(), l.numbers.data(), sizeof(lw));
+				std::memcpy(rw.data(), r.numbers.data(), sizeof(rw));
+				std::memcpy(sum.data(), result.numbers.data(), sizeof(sum));
+				kernels::mul_add(sum.data(), lw.data(), rw.data(), word_count);
+				std::memcpy(result.numbers.data(), sum.data(), sizeof(sum));
+				return result;
+			}
 		}
-		else if(l < r)
+#endif
+		for(std::size_t i = 0; i < sizeof... (I); i++)
+		{
+			B carry = 0;
+			for(std::size_t j = 0; i + j < sizeof... (I); j++)
+			{
+				auto [lo, hi] = mul_wide(l.numbers[i], r.numbers[j]);
+				B & sum = result.numbers[i+j];
+				sum += lo;
+				hi += sum < lo;
+				sum += carry;
+				hi += sum < carry;
+				carry = hi;
+			}
+		}
+		return result;
+	}
+
+	/// l * r + a - s, a - s is the start value of the product columns
+	static constexpr BigInteger mul_add_sub(const BigInteger & l, const BigInteger & r, const BigInteger & a, const BigInteger & s)
+	{
+		return mul_add(l, r, a - s);
+	}
+
+	/// Full double width l * r + a, no bits are lost
+	static constexpr BigInteger<B,is_signed,I...,(sizeof... (I) + I)...> mul_add_wide(const BigInteger & l, const BigInteger & r, const BigInteger & a)
+	{
+		constexpr std::size_t N = sizeof... (I);
+		BigInteger<B,is_signed,I...,(sizeof... (I) + I)...> result;
+		for(std::size_t i = 0; i < N; i++)
 		{
-			/// use copy constructor for l
-			return std::make_pair(0u,l);
+			result.numbers[i] = a.numbers[i];
 		}
-		else if (one << msb_r == r)  // check if r is from type 2^n
+		for(std::size_t i = 0; i < N; i++)
 		{
-			return std::make_pair(l>>msb_r, l & (r - 1u));
+			B carry = 0;
+			for(std::size_t j = 0; j < N; j++)
+			{
+				auto [lo, hi] = mul_wide(l.numbers[i], r.numbers[j]);
+				B & sum = result.numbers[i+j];
+				sum += lo;
+				hi += sum < lo;
+				sum += carry;
+				hi += sum < carry;
+				carry = hi;
+			}
+			result.numbers[i+N] = carry;
 		}
-		auto msb_l = bits(l);
-		auto diff_msb = msb_l - msb_r;
-		/// use copy constructor for l
-		BigInteger ll = l;
-		BigInteger rr = r << diff_msb;
-		BigInteger i = one << diff_msb;
-		BigInteger div;
-		while(i)
+		if constexpr(is_signed)
 		{
-			if(ll >= rr)
+			/// two's complement: subtract the other factor from the high half for
+			/// each negative factor, sign extend the addend
+			auto sub_high = [&result](const BigInteger & x)
 			{
-				div |= i;
-				ll -= rr;
+				B borrow = 0;
+				for(std::size_t i = 0; i < N; i++)
+				{
+					B & d = result.numbers[i+N];
+					const B t = d - borrow;
+					borrow = t > d;
+					d = t - x.numbers[i];
+					borrow += d > t;
+				}
+			};
+			if(l.negative())
+			{
+				sub_high(r);
+			}
+			if(r.negative())
+			{
+				sub_high(l);
+			}
+			if(a.negative())
+			{
+				sub_high(BigInteger(1u));
 			}
-			rr >>= 1u;
-			i >>= 1u;
 		}
-		return std::make_pair(std::forward<BigInteger>(div),std::forward<BigInteger>(ll));
+		return result;
 	}
 
-	/// {} makes value initialization for non class non array types like int to its default value 0
-	std::array<B,sizeof... (I)> numbers{};
-};
-
-namespace uint128 {
-typedef BigInteger<uint64_t,false,0,1> uint128_t;
-
-/// literal operator
-template<char ...digits>
-constexpr uint128_t operator "" _num() noexcept
-{
-	return uint128_t::to_number<digits...>();
-}
-}
+	/// Element wise sums and differences, the batch word kernels run over the whole range
+	static constexpr void add_batch(std::span<const BigInteger> l, std::span<const BigInteger> r, std::span<BigInteger> out)
+	{
+		batch<false>(l, r, out);
+	}
 
-namespace uint256 {
-typedef BigInteger<__uint128_t,false,0,1> uint256_t;
+	static constexpr void sub_batch(std::span<const BigInteger> l, std::span<const BigInteger> r, std::span<BigInteger> out)
+	{
+		batch<true>(l, r, out);
+	}
 
-/// literal operator
-template<char ...digits>
-constexpr uint256_t operator "" _num() noexcept
-{
-	return uint256_t::to_number<digits...>();
-}
-}
+	/// Element wise three way compare into -1, 0 and 1 by the compare word kernel
+	static void compare_batch(std::span<const BigInteger> l, std::span<const BigInteger> r, std::span<int8_t> out)
+	{
+		if(l.size() != r.size() || l.size() != out.size())
+		{
+			detail::invalid_argument("Different sizes!");
+		}
+#ifndef BIGINTEGER_HEADER_ONLY
+		if constexpr(kernel_layout)
+		{
+			if constexpr(std::same_as<B,uint64_t>)
+			{
+				/// the blocks are the words, no copy needed
+				if(!out.empty())
+				{
+					kernels::compare_batch(out.data(), l.front().numbers.data(), r.front().numbers.data(), word_count, out.size(), is_signed);
+				}
+			}
+			else
+			{
+				/// chunks of about 8 KiB per operand stay in the L1 cache between the copies
+				constexpr std::size_t chunk = std::max<std::size_t>(1, 1024 / word_count);
+				std::array<uint64_t,chunk * word_count> a, b;
+				for(std::size_t k = 0; k < out.size(); k += chunk)
+				{
+					const std::size_t count = std::min(chunk, out.size() - k);
+					std::memcpy(a.data(), l.data() + k, count * sizeof(BigInteger));
+					std::memcpy(b.data(), r.data() + k, count * sizeof(BigInteger));
+					kernels::compare_batch(out.data() + k, a.data(), b.data(), word_count, count, is_signed);
+				}
+			}
+			return;
+		}
+#endif
+		for(std::size_t i = 0; i < l.size(); i++)
+		{
+			const auto lw = l[i].to_words();
+			const auto rw = r[i].to_words();
+			int8_t result = 0;
+			for(std::size_t j = 0; j + 1 < lw.size(); j++)
+			{
+				const int8_t c = (lw[j] > rw[j]) - (lw[j] < rw[j]);
+				result = c ? c : result;
+			}
+			const int8_t c = is_signed ? (int64_t(lw.back()) > int64_t(rw.back())) - (int64_t(lw.back()) < int64_t(rw.back())) :
+					(lw.back() > rw.back()) - (lw.back() < rw.back());
+			out[i] = c ? c : result;
+		}
+	}
 
-namespace uint512 {
+	/// Sum of l[k] * r[k], the columns are accumulated with their carry counts and
+	/// normalized once at the end
+	static constexpr BigInteger dot_product(std::span<const BigInteger> l, std::span<const BigInteger> r)
+	{
+		constexpr std::size_t N = sizeof... (I);
+		std::array<B,N> sums{};
+		std::array<B,N> carries{};
+		if(l.size() != r.size())
+		{
+			detail::invalid_argument("Different sizes!");
+		}
+		for(std::size_t k = 0; k < l.size(); k++)
+		{
+			for(std::size_t i = 0; i < N; i++)
+			{
+				for(std::size_t j = 0; i + j < N; j++)
+				{
+					const auto [lo, hi] = mul_wide(l[k].numbers[i], r[k].numbers[j]);
+					sums[i+j] += lo;
+					carries[i+j] += sums[i+j] < lo;
+					if(i + j + 1 < N)
+					{
+						sums[i+j+1] += hi;
+						carries[i+j+1] += sums[i+j+1] < hi;
+					}
+				}
+			}
+		}
+		BigInteger result;
+		B carry = 0;
+		for(std::size_t i = 0; i < N; i++)
+		{
+			result.numbers[i] = sums[i] + carry;
+			carry = result.numbers[i] < carry;
+			if(i > 0)
+			{
+				result.numbers[i] += carries[i-1];
+				carry += result.numbers[i] < carries[i-1];
+			}
+		}
+		return result;
+	}
+
+	/// l + r - s with carry and borrow chain in the same pass
+	static constexpr BigInteger add_sub(const BigInteger & l, const BigInteger & r, const BigInteger & s)
+	{
+		BigInteger result;
+		B carry = 0;
+		B borrow = 0;
+		for(std::size_t i = 0; i < sizeof... (I); i++)
+		{
+			B sum = l.numbers[i] + carry;
+			carry = sum < carry;
+			sum += r.numbers[i];
+			carry += sum < r.numbers[i];
+			B diff = sum - borrow;
+			borrow = diff > sum;
+			result.numbers[i] = diff - s.numbers[i];
+			borrow += result.numbers[i] > diff;
+		}
+		return result;
+	}
+
+	/// (l << n) | r
+	template<std::unsigned_integral T>
+	static constexpr BigInteger shl_or(const BigInteger & l, const T & n, const BigInteger & r)
+	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		const std::size_t chunk_shift = n / num_bits;
+		const std::size_t left = n % num_bits;
+		BigInteger result = r;
+		for(std::size_t i = chunk_shift; i < sizeof... (I); i++)
+		{
+			result.numbers[i] |= l.numbers[i - chunk_shift] << left;
+			if(left && i > chunk_shift)
+			{
+				result.numbers[i] |= l.numbers[i - chunk_shift - 1] >> (num_bits - left);
+			}
+		}
+		return result;
+	}
+
+	template<char ...digits>
+	static constexpr BigInteger to_number() noexcept
+	{
+		constexpr std::array<char, sizeof...(digits)> digits_array{ digits... };
+		constexpr bool is_hex = sizeof... (digits) > 2 && sizeof... (digits) <= ((bit_size>>2)+2) && digits_array[0] == '0' && digits_array[1] == 'x';
+		constexpr bool is_oct = sizeof... (digits) > 1 && sizeof... (digits) <= (bit_size/3+1) && digits_array[0] == '0' &&
+				(('0' <= digits && digits <= '7') && ...);
+		constexpr bool is_dec = sizeof... (digits) > 0 && sizeof... (digits) <= (static_cast<float>(bit_size)/3.32f) &&
+				(('0' <= digits && digits <= '9') && ...);
+		static_assert(is_hex || is_oct || is_dec, "invalid digit in number");
+		if constexpr(is_hex)
+		{
+			// remove hex 0x
+			return parse_power_of_two<2>(digits_array, 4);
+		}
+		else if constexpr(is_oct)
+		{
+			// remove oct 0
+			return parse_power_of_two<1>(digits_array, 3);
+		}
+		else if constexpr(is_dec)
+		{
+			return parse_decimal(digits_array);
+		}
+	}
+
+	static constexpr std::size_t bit_size = sizeof(B) * sizeof... (I) * 8;
+
+	/// Number of 64 bit words of the integer.
+	static constexpr std::size_t word_count = bit_size / 64;
+
+	/// Get the value as little endian array of 64 bit words.
+	constexpr std::array<uint64_t,word_count> to_words() const
+	{
+		static_assert(bit_size % 64 == 0, "Size must be a multiple of 64 bit");
+		constexpr auto num_bits = std::numeric_limits<B>::digits;
+		std::array<uint64_t,word_count> words{};
+		if constexpr(num_bits >= 64)
+		{
+			for(std::size_t i = 0; i < word_count; i++)
+			{
+				words[i] = static_cast<uint64_t>(numbers[(i * 64) / num_bits] >> ((i * 64) % num_bits));
+			}
+		}
+		else
+		{
+			for(std::size_t i = 0; i < sizeof... (I); i++)
+			{
+				words[(i * num_bits) / 64] |= static_cast<uint64_t>(numbers[i]) << ((i * num_bits) % 64);
+			}
+		}
+		return words;
+	}
+
+	/// Build the value from a little endian array of 64 bit words.
+	static constexpr BigInteger from_words(const std::array<uint64_t,word_count> & words)
+	{
+		static_assert(bit_size % 64 == 0, "Size must be a multiple of 64 bit");
+		constexpr auto num_bits = std::numeric_limits<B>::digits;
+		BigInteger n;
+		if constexpr(num_bits >= 64)
+		{
+			for(std::size_t i = 0; i < word_count; i++)
+			{
+				n.numbers[(i * 64) / num_bits] |= static_cast<B>(words[i]) << ((i * 64) % num_bits);
+			}
+		}
+		else
+		{
+			for(std::size_t i = 0; i < sizeof... (I); i++)
+			{
+				n.numbers[i] = static_cast<B>(words[(i * num_bits) / 64] >> ((i * num_bits) % 64));
+			}
+		}
+		return n;
+	}
+
+private:
+	/// The blocks are little endian 64 bit words in memory, as the word kernels expect.
+	/// __uint128_t blocks must not be accessed as uint64_t, the kernels get copies of them.
+	static constexpr bool kernel_layout = (std::numeric_limits<B>::digits == 64 || std::numeric_limits<B>::digits == 128) &&
+			std::endian::native == std::endian::little;
+
+	template<bool subtract>
+	static constexpr void batch(std::span<const BigInteger> l, std::span<const BigInteger> r, std::span<BigInteger> out)
+	{
+		if(l.size() != r.size() || l.size() != out.size())
+		{
+			detail::invalid_argument("Different sizes!");
+		}
+#ifndef BIGINTEGER_HEADER_ONLY
+		if constexpr(kernel_layout)
+		{
+			if(!std::is_constant_evaluated())
+			{
+				auto kernel = subtract ? kernels::sub_batch : kernels::add_batch;
+				if constexpr(std::same_as<B,uint64_t>)
+				{
+					/// the blocks are the words, no copy needed
+					if(!out.empty())
+					{
+						kernel(out.front().numbers.data(), l.front().numbers.data(), r.front().numbers.data(), word_count, out.size());
+					}
+				}
+				else
+				{
+					/// chunks of about 8 KiB per operand stay in the L1 cache between the copies
+					constexpr std::size_t chunk = std::max<std::size_t>(1, 1024 / word_count);
+					std::array<uint64_t,chunk * word_count> a, b, result;
+					for(std::size_t k = 0; k < out.size(); k += chunk)
+					{
+						const std::size_t count = std::min(chunk, out.size() - k);
+						std::memcpy(a.data(), l.data() + k, count * sizeof(BigInteger));
+						std::memcpy(b.data(), r.data() + k, count * sizeof(BigInteger));
+						kernel(result.data(), a.data(), b.data(), word_count, count);
+						std::memcpy(static_cast<void *>(out.data() + k), result.data(), count * sizeof(BigInteger));
+					}
+				}
+				return;
+			}
+		}
+#endif
+		for(std::size_t i = 0; i < out.size(); i++)
+		{
+			out[i] = subtract ? l[i] - r[i] : l[i] + r[i];
+		}
+	}
+
+	/// Sign bit, always false for unsigned types
+	constexpr bool negative() const
+	{
+		if constexpr(is_signed)
+		{
+			return numbers[sizeof... (I) - 1] >> (std::numeric_limits<B>::digits - 1);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	static constexpr int countl_zero_block(const B & n)
+	{
+		if constexpr(std::numeric_limits<B>::digits <= 64)
+		{
+			return std::countl_zero(n);
+		}
+		else
+		{
+			const uint64_t high = static_cast<uint64_t>(n >> 64);
+			return high ? std::countl_zero(high) : 64 + std::countl_zero(static_cast<uint64_t>(n));
+		}
+	}
+
+	/// Full product of two blocks as {low, high} block.
+	static constexpr std::pair<B,B> mul_wide(const B & l, const B & r)
+	{
+		constexpr auto num_bits = std::numeric_limits<B>::digits;
+		if constexpr(num_bits <= 32)
+		{
+			uint64_t p = uint64_t(l) * r;
+			return {B(p), B(p >> num_bits)};
+		}
+		else if constexpr(num_bits == 64)
+		{
+			__uint128_t p = __uint128_t(l) * r;
+			return {B(p), B(p >> num_bits)};
+		}
+		else
+		{
+			/// split into half blocks, the middle sum can not overflow a block
+			constexpr auto num_bits_half = num_bits >> 1;
+			constexpr B mask = std::numeric_limits<B>::max() >> num_bits_half;
+			B l0 = l & mask, l1 = l >> num_bits_half;
+			B r0 = r & mask, r1 = r >> num_bits_half;
+			B p00 = l0 * r0, p01 = l0 * r1, p10 = l1 * r0, p11 = l1 * r1;
+			B mid = (p00 >> num_bits_half) + (p01 & mask) + (p10 & mask);
+			return {(mid << num_bits_half) | (p00 & mask),
+					p11 + (p01 >> num_bits_half) + (p10 >> num_bits_half) + (mid >> num_bits_half)};
+		}
+	}
+
+	template<std::unsigned_integral T>
+	static constexpr BigInteger exp_by_squaring(BigInteger&& y, BigInteger&& x, T n)
+	{
+		if(n == 0)
+			return std::forward<BigInteger>(y);
+		else if(n == 1)
+			return x * y;
+		else if(n & 1) // odd
+			return exp_by_squaring( x * y, x * x, (n - 1)>>1);
+		else // even
+			return exp_by_squaring( std::forward<BigInteger>(y), x * x, n>>1);
+	}
+
+	static constexpr B digit_value(char c)
+	{
+		return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c - 'A' + 10;
+	}
+
+	/// Hex and octal digits are placed directly at their bit position, starting with the last digit
+	template<std::size_t offset, std::size_t size>
+	static constexpr BigInteger parse_power_of_two(const std::array<char,size> & str, std::size_t bits_per_digit)
+	{
+		constexpr std::size_t num_bits = std::numeric_limits<B>::digits;
+		BigInteger value;
+		std::size_t bit = 0;
+		for(std::size_t index = size; index-- > offset && bit < bit_size; bit += bits_per_digit)
+		{
+			const B digit = digit_value(str[index]);
+			const std::size_t block = bit / num_bits;
+			const std::size_t shift = bit % num_bits;
+			value.numbers[block] |= digit << shift;
+			if(shift + bits_per_digit > num_bits && block + 1 < sizeof... (I))
+			{
+				value.numbers[block + 1] |= digit >> (num_bits - shift);
+			}
+		}
+		return value;
+	}
+
+	/// Decimal digits are collected in chunks of up to 19 digits, each chunk is one
+	/// multiply by a power of ten and add over the blocks
+	template<std::size_t size>
+	static constexpr BigInteger parse_decimal(const std::array<char,size> & str)
+	{
+		constexpr std::size_t chunk_digits = std::min(std::numeric_limits<B>::digits10, 19);
+		BigInteger value;
+		std::size_t index = 0;
+		std::size_t length = size % chunk_digits ? size % chunk_digits : chunk_digits;
+		while(index < size)
+		{
+			B chunk = 0;
+			B scale = 1;
+			for(std::size_t end = index + length; index < end; index++)
+			{
+				chunk = chunk * 10u + digit_value(str[index]);
+				scale *= 10u;
+			}
+			B carry = chunk;
+			for(std::size_t i = 0; i < sizeof... (I); i++)
+			{
+				auto [lo, hi] = mul_wide(value.numbers[i], scale);
+				lo += carry;
+				hi += lo < carry;
+				value.numbers[i] = lo;
+				carry = hi;
+			}
+			length = chunk_digits;
+		}
+		return value;
+	}
+
+	/// Unsigned shift and subtract division, the inputs are read before an output is written
+	static constexpr std::errc divmod_unsigned(const BigInteger & l, const BigInteger & r, BigInteger & q, BigInteger & rem) noexcept
+		requires (!is_signed)
+	{
+		if(!r)
+		{
+			return std::errc::invalid_argument;
+		}
+		else if(l < r)
+		{
+			rem.numbers = l.numbers;
+			q.numbers = {};
+			return std::errc();
+		}
+		const auto msb_r = bits(r);
+		if(!(r & (r - 1u)))  // check if r is from type 2^n
+		{
+			BigInteger quotient = l >> msb_r;
+			rem = l & (r - 1u);
+			q = std::move(quotient);
+			return std::errc();
+		}
+		const auto diff_msb = bits(l) - msb_r;
+		BigInteger rr = r << diff_msb;
+		rem.numbers = l.numbers;
+		q.numbers = {};
+		for(std::size_t bit = diff_msb + 1; bit-- > 0;)
+		{
+			if(rem >= rr)
+			{
+				q.set(bit);
+				rem -= rr;
+			}
+			rr >>= 1u;
+		}
+		return std::errc();
+	}
+
+	/// {} makes value initialization for non class non array types like int to its default value 0
+	std::array<B,sizeof... (I)> numbers{};
+};
+
+template<typename T>
+struct is_big_integer : std::false_type {};
+
+template<std::unsigned_integral B, bool is_signed, std::size_t ...I>
+struct is_big_integer<BigInteger<B,is_signed,I...>> : std::true_type {};
+
+template<typename T>
+concept big_integer = is_big_integer<T>::value;
+
+/// BigInteger type with one more block
+template<typename T>
+struct widen;
+
+template<std::unsigned_integral B, bool is_signed, std::size_t ...I>
+struct widen<BigInteger<B,is_signed,I...>>
+{
+	using type = BigInteger<B,is_signed,I...,sizeof... (I)>;
+};
+
+template<typename T>
+using widen_t = typename widen<T>::type;
+
+/// BigInteger type with twice the blocks, holds a full product
+template<typename T>
+struct double_width;
+
+template<std::unsigned_integral B, bool is_signed, std::size_t ...I>
+struct double_width<BigInteger<B,is_signed,I...>>
+{
+	using type = BigInteger<B,is_signed,I...,(sizeof... (I) + I)...>;
+};
+
+template<typename T>
+using double_width_t = typename double_width<T>::type;
+
+namespace detail {
+
+template<std::unsigned_integral B, bool is_signed, typename S>
+struct big_int_blocks;
+
+template<std::unsigned_integral B, bool is_signed, std::size_t ...I>
+struct big_int_blocks<B,is_signed,std::index_sequence<I...>>
+{
+	using type = BigInteger<B,is_signed,I...>;
+};
+
+/// 128 bit blocks where they fit, 64 bit blocks otherwise
+template<std::size_t Bits>
+using default_limb = std::conditional_t<Bits % 128 == 0 && Bits / 128 >= 2, __uint128_t, uint64_t>;
+
+}
+
+/// BigInteger type of Bits width, Bits must be a multiple of at least two limbs
+template<std::size_t Bits, bool Signed = false, std::unsigned_integral Limb = detail::default_limb<Bits>>
+	requires (Bits % std::numeric_limits<Limb>::digits == 0 && Bits / std::numeric_limits<Limb>::digits >= 2)
+using BigInt = typename detail::big_int_blocks<Limb,Signed,std::make_index_sequence<Bits / std::numeric_limits<Limb>::digits>>::type;
+
+/// Same value in the block layout of To
+template<big_integer To, std::unsigned_integral B, bool is_signed, std::size_t ...I>
+constexpr To limb_cast(const BigInteger<B,is_signed,I...> & n)
+{
+	if constexpr(std::is_same_v<To, BigInteger<B,is_signed,I...>>)
+	{
+		return n;
+	}
+	else
+	{
+		return To(n);
+	}
+}
+
+/// Operations with a measured limb preference
+enum class limb_operation { add, multiply, divide, shift };
+
+namespace detail {
+
+/// 64 bit limbs measured faster with benchmarks/limbs.cpp, which prints this table. Each cell
+/// compares the medians of nine runs and is true only if 64 bit limbs are 10 % faster and
+/// their upper quartile is below the lower quartile of 128 bit limbs, in four of four runs of
+/// the benchmark. Measured with GCC 12.2 -O3 on an Intel Xeon (family 6 model 207, Emerald
+/// Rapids, AVX-512) at 2.1 GHz. Rows 256, 512, 1024, 2048 and 4096 bit, columns add, multiply,
+/// divide, shift.
+inline constexpr bool limb64_faster[5][4] = {
+	{false, false, false, false},
+	{false, true,  false, false},
+	{false, false, false, false},
+	{false, false, false, false},
+	{false, false, false, false},
+};
+
+/// Widths between the measured ones use the row below
+constexpr bool prefer_limb64(std::size_t bits, limb_operation op)
+{
+	if(bits % 128 != 0 || bits < 256)
+	{
+		return true;
+	}
+	std::size_t row = 0;
+	while(row < 4 && (std::size_t(256) << (row + 1)) <= bits)
+	{
+		row++;
+	}
+	return limb64_faster[row][static_cast<std::size_t>(op)];
+}
+
+}
+
+/// Faster limb type for an operation on Bits wide integers
+template<std::size_t Bits, limb_operation Op>
+struct fast_limb
+{
+	using type = std::conditional_t<detail::prefer_limb64(Bits, Op), uint64_t, __uint128_t>;
+};
+
+template<std::size_t Bits, limb_operation Op>
+using fast_limb_t = typename fast_limb<Bits,Op>::type;
+
+/// BigInt of Bits width with the faster limb type for Op
+template<std::size_t Bits, limb_operation Op, bool Signed = false>
+using FastBigInt = BigInt<Bits,Signed,fast_limb_t<Bits,Op>>;
+
+/// Element type of a span over BigIntegers
+template<typename T>
+concept big_integer_element = big_integer<std::remove_const_t<T>>;
+
+/// Sign
+
+/// Absolute value, min() of a signed type wraps to itself
+template<big_integer T>
+constexpr T abs(const T & n)
+{
+	return n < 0u ? -n : n;
+}
+
+/// -1, 0 or 1
+template<big_integer T>
+constexpr int sign(const T & n)
+{
+	return (n > 0u) - (n < 0u);
+}
+
+/// Division
+
+/// Quotient and remainder into caller storage, std::errc::invalid_argument for b == 0.
+/// Signed types truncate toward zero.
+template<big_integer T>
+constexpr std::errc divmod(const T & a, const T & b, T & q, T & rem) noexcept
+{
+	return T::divmod(a, b, q, rem);
+}
+
+/// Overflow and saturation
+
+/// a + b and whether the exact sum does not fit into T
+template<big_integer T>
+constexpr std::pair<T,bool> add_overflow(const T & a, const T & b)
+{
+	return T::add_overflow(a, b);
+}
+
+/// a - b and whether the exact difference does not fit into T
+template<big_integer T>
+constexpr std::pair<T,bool> sub_overflow(const T & a, const T & b)
+{
+	return T::sub_overflow(a, b);
+}
+
+/// a * b and whether the exact product does not fit into T
+template<big_integer T>
+constexpr std::pair<T,bool> mul_overflow(const T & a, const T & b)
+{
+	return T::mul_overflow(a, b);
+}
+
+/// a + b clamped to [T::min(), T::max()]
+template<big_integer T>
+constexpr T add_sat(const T & a, const T & b)
+{
+	auto [sum, overflow] = T::add_overflow(a, b);
+	if(!overflow)
+	{
+		return sum;
+	}
+	return a < 0u ? T::min() : T::max();
+}
+
+/// a - b clamped to [T::min(), T::max()]
+template<big_integer T>
+constexpr T sub_sat(const T & a, const T & b)
+{
+	auto [diff, overflow] = T::sub_overflow(a, b);
+	if(!overflow)
+	{
+		return diff;
+	}
+	return a < b ? T::min() : T::max();
+}
+
+/// a * b clamped to [T::min(), T::max()]
+template<big_integer T>
+constexpr T mul_sat(const T & a, const T & b)
+{
+	auto [product, overflow] = T::mul_overflow(a, b);
+	if(!overflow)
+	{
+		return product;
+	}
+	return (a < 0u) != (b < 0u) ? T::min() : T::max();
+}
+
+/// Fused multiply add
+
+/// a * b + c in one multiply pass, the addend is folded into the first column
+template<big_integer T>
+constexpr T fma(const T & a, const T & b, const T & c)
+{
+	return T::mul_add(a, b, c);
+}
+
+/// a * b + c with the full double width product
+template<big_integer T>
+constexpr double_width_t<T> fma_wide(const T & a, const T & b, const T & c)
+{
+	return T::mul_add_wide(a, b, c);
+}
+
+/// Sum of a[k] * b[k] mod 2^bit_size, the products and the sum wrap like operator* and
+/// operator+. Spans of different length throw std::invalid_argument. For the exact sum
+/// accumulate fma_wide products, or the products of a wider type in an Accumulator.
+template<big_integer_element L, big_integer_element R>
+	requires std::is_same_v<std::remove_const_t<L>, std::remove_const_t<R>>
+constexpr std::remove_const_t<L> dot(std::span<L> a, std::span<R> b)
+{
+	using T = std::remove_const_t<L>;
+	return T::dot_product(std::span<const T>(a), std::span<const T>(b));
+}
+
+/// Carry-less products, the bits are the coefficients of polynomials over GF(2)
+
+namespace detail {
+
+/// 64 x 64 bit carry-less product as {low, high} word
+constexpr std::pair<uint64_t,uint64_t> clmul_word(uint64_t a, uint64_t b)
+{
+	uint64_t lo = 0;
+	uint64_t hi = 0;
+	for(int i = 0; i < 64; i++)
+	{
+		const uint64_t mask = -((b >> i) & 1);
+		lo ^= (a << i) & mask;
+		hi ^= i ? (a >> (64 - i)) & mask : 0;
+	}
+	return {lo, hi};
+}
+
+}
+
+/// Full product of a and b as binary polynomials, PCLMULQDQ at run time
+template<big_integer T>
+constexpr double_width_t<T> clmul_wide(const T & a, const T & b)
+{
+	constexpr std::size_t N = T::word_count;
+	const auto l = a.to_words();
+	const auto r = b.to_words();
+	std::array<uint64_t,2 * N> product{};
+#ifndef BIGINTEGER_HEADER_ONLY
+	if(!std::is_constant_evaluated())
+	{
+		kernels::clmul(product.data(), l.data(), r.data(), N);
+		return double_width_t<T>::from_words(product);
+	}
+#endif
+	for(std::size_t i = 0; i < N; i++)
+	{
+		for(std::size_t j = 0; j < N; j++)
+		{
+			const auto [lo, hi] = detail::clmul_word(l[i], r[j]);
+			product[i+j] ^= lo;
+			product[i+j+1] ^= hi;
+		}
+	}
+	return double_width_t<T>::from_words(product);
+}
+
+/// Carry-less product truncated to the width of T, like operator*
+template<big_integer T>
+constexpr T clmul(const T & a, const T & b)
+{
+	const auto product = clmul_wide(a, b).to_words();
+	std::array<uint64_t,T::word_count> low;
+	std::copy(product.begin(), product.begin() + T::word_count, low.begin());
+	return T::from_words(low);
+}
+
+/// x mod (X^bit_size + poly) in GF(2)[X], poly holds the terms below X^bit_size, e.g. 0x87
+/// for the GCM field X^128 + X^7 + X^2 + X + 1. The high half is folded down with
+/// carry-less products until it is zero, twice for a poly of degree below bit_size / 2.
+template<big_integer T>
+constexpr T gf2_reduce(const double_width_t<T> & x, const T & poly)
+{
+	constexpr std::size_t N = T::word_count;
+	const auto words = x.to_words();
+	std::array<uint64_t,N> low, high;
+	std::copy(words.begin(), words.begin() + N, low.begin());
+	std::copy(words.begin() + N, words.end(), high.begin());
+	while(std::any_of(high.begin(), high.end(), [](uint64_t w) { return w != 0; }))
+	{
+		const auto folded = clmul_wide(T::from_words(high), poly).to_words();
+		for(std::size_t i = 0; i < N; i++)
+		{
+			low[i] ^= folded[i];
+			high[i] = folded[i+N];
+		}
+	}
+	return T::from_words(low);
+}
+
+/// a * b in GF(2^bit_size) with the field polynomial X^bit_size + poly
+template<big_integer T>
+constexpr T gf2_mul(const T & a, const T & b, const T & poly)
+{
+	return gf2_reduce(clmul_wide(a, b), poly);
+}
+
+/// Bit queries
+
+/// Number of set bits.
+template<big_integer T>
+constexpr std::size_t popcount(const T & n)
+{
+	std::size_t count = 0;
+	for(auto w : n.to_words())
+	{
+		count += std::popcount(w);
+	}
+	return count;
+}
+
+/// Number of consecutive zero bits starting at the lsb, bit_size for 0.
+template<big_integer T>
+constexpr std::size_t countr_zero(const T & n)
+{
+	const auto words = n.to_words();
+	std::size_t count = T::bit_size;
+	for(std::size_t i = words.size(); i-- > 0;)
+	{
+		count = words[i] ? i * 64 + std::countr_zero(words[i]) : count;
+	}
+	return count;
+}
+
+/// Number of consecutive zero bits starting at the msb, bit_size for 0.
+template<big_integer T>
+constexpr std::size_t countl_zero(const T & n)
+{
+	const auto words = n.to_words();
+	std::size_t count = T::bit_size;
+	for(std::size_t i = 0; i < words.size(); i++)
+	{
+		count = words[i] ? (words.size() - 1 - i) * 64 + std::countl_zero(words[i]) : count;
+	}
+	return count;
+}
+
+/// Number of bits needed to represent the bit pattern, 0 for 0.
+template<big_integer T>
+constexpr std::size_t bit_width(const T & n)
+{
+	return T::bit_size - countl_zero(n);
+}
+
+/// Arrays
+
+/// Sort ascending with a most significant digit first radix sort on bytes.
+/// The values move between the range and one buffer, every level scatters in the
+/// other direction. Bytes equal for all values of a bucket are skipped and buckets below
+/// 64 values are finished by std::sort.
+template<big_integer T>
+void sort(std::span<T> values)
+{
+	if constexpr(T::bit_size > 512)
+	{
+		/// moving values of 128 bytes and more through the buffer costs more than the saved compares
+		std::sort(values.begin(), values.end());
+		return;
+	}
+	constexpr std::size_t digits = T::bit_size / 8;
+	constexpr uint64_t sign = T(0u) > ~T(0u) ? 0x80 : 0;
+	std::vector<T> buffer(values.size());
+	auto digit = [](const T & n, std::size_t d) {
+		return n.extract(T::bit_size - 8 * (d + 1), 8) ^ (d == 0 ? sign : 0);
+	};
+	auto radix = [&](auto & self, std::span<T> from, std::span<T> to, bool from_values, std::size_t d) -> void {
+		for(; d < digits && from.size() >= 64; d++)
+		{
+			std::array<std::size_t,257> offset{};
+			for(const auto & v : from)
+			{
+				offset[digit(v, d) + 1]++;
+			}
+			if(std::find(offset.begin(), offset.end(), from.size()) != offset.end())
+			{
+				/// all values share this digit
+				continue;
+			}
+			for(std::size_t b = 1; b < offset.size(); b++)
+			{
+				offset[b] += offset[b-1];
+			}
+			auto position = offset;
+			for(auto & v : from)
+			{
+				to[position[digit(v, d)]++] = std::move(v);
+			}
+			for(std::size_t b = 0; b + 1 < offset.size(); b++)
+			{
+				self(self, to.subspan(offset[b], offset[b+1] - offset[b]), from.subspan(offset[b], offset[b+1] - offset[b]), !from_values, d + 1);
+			}
+			return;
+		}
+		std::sort(from.begin(), from.end());
+		if(!from_values)
+		{
+			std::move(from.begin(), from.end(), to.begin());
+		}
+	};
+	/// start at the highest byte in which any two values differ
+	T diff;
+	for(const auto & v : values)
+	{
+		diff |= v ^ values.front();
+	}
+	radix(radix, values, buffer, true, countl_zero(diff) / 8);
+}
+
+/// Element wise three way compare, out[i] is -1, 0 or 1 for l[i] <, == or > r[i].
+/// At run time the values are compared by the AVX-512 or AVX2 word kernel, 64 bit blocks
+/// in place and 128 bit blocks in copied chunks.
+template<big_integer_element L, big_integer_element R>
+	requires std::same_as<std::remove_const_t<L>,std::remove_const_t<R>>
+void compare_many(std::span<L> l, std::span<R> r, std::span<int8_t> out)
+{
+	using T = std::remove_const_t<L>;
+	T::compare_batch(std::span<const T>(l), std::span<const T>(r), out);
+}
+
+/// Element wise out[i] = a[i] + b[i] and out[i] = a[i] - b[i], wrapping like the operators.
+template<big_integer_element L, big_integer_element R>
+	requires std::same_as<std::remove_const_t<L>,std::remove_const_t<R>>
+constexpr void add_many(std::span<L> a, std::span<R> b, std::span<std::remove_const_t<L>> out)
+{
+	using T = std::remove_const_t<L>;
+	T::add_batch(std::span<const T>(a), std::span<const T>(b), out);
+}
+
+template<big_integer_element L, big_integer_element R>
+	requires std::same_as<std::remove_const_t<L>,std::remove_const_t<R>>
+constexpr void sub_many(std::span<L> a, std::span<R> b, std::span<std::remove_const_t<L>> out)
+{
+	using T = std::remove_const_t<L>;
+	T::sub_batch(std::span<const T>(a), std::span<const T>(b), out);
+}
+
+/// Smallest value of a non empty range.
+template<big_integer_element T>
+constexpr std::remove_const_t<T> min(std::span<T> values)
+{
+	if(values.empty())
+	{
+		detail::invalid_argument("Empty range!");
+	}
+	const auto * result = &values.front();
+	for(const auto & v : values.subspan(1))
+	{
+		result = v < *result ? &v : result;
+	}
+	return *result;
+}
+
+/// Largest value of a non empty range.
+template<big_integer_element T>
+constexpr std::remove_const_t<T> max(std::span<T> values)
+{
+	if(values.empty())
+	{
+		detail::invalid_argument("Empty range!");
+	}
+	const auto * result = &values.front();
+	for(const auto & v : values.subspan(1))
+	{
+		result = v > *result ? &v : result;
+	}
+	return *result;
+}
+
+/// First value not less than key in a sorted range.
+template<big_integer_element T>
+constexpr typename std::span<T>::iterator lower_bound(std::span<T> values, const std::remove_const_t<T> & key)
+{
+	std::size_t first = 0;
+	std::size_t count = values.size();
+	while(count > 0)
+	{
+		const std::size_t half = count / 2;
+		if(values[first + half] < key)
+		{
+			first += half + 1;
+			count -= half + 1;
+		}
+		else
+		{
+			count = half;
+		}
+	}
+	return values.begin() + first;
+}
+
+namespace detail {
+
+/// Helpers on little endian 64 bit word arrays
+
+/// l += r, returns the carry
+template<std::size_t N>
+constexpr uint64_t add_words(std::array<uint64_t,N> & l, const std::array<uint64_t,N> & r)
+{
+	uint64_t carry = 0;
+	for(std::size_t i = 0; i < N; i++)
+	{
+		uint64_t temp = l[i] + carry;
+		carry = temp < carry;
+		l[i] = temp + r[i];
+		carry |= l[i] < temp;
+	}
+	return carry;
+}
+
+/// l -= r, returns the borrow
+template<std::size_t N>
+constexpr uint64_t sub_words(std::array<uint64_t,N> & l, const std::array<uint64_t,N> & r)
+{
+	uint64_t borrow = 0;
+	for(std::size_t i = 0; i < N; i++)
+	{
+		uint64_t temp = l[i] - borrow;
+		borrow = temp > l[i];
+		l[i] = temp - r[i];
+		borrow |= l[i] > temp;
+	}
+	return borrow;
+}
+
+/// Unsigned three way compare
+template<std::size_t N>
+constexpr std::strong_ordering compare_words(const std::array<uint64_t,N> & l, const std::array<uint64_t,N> & r)
+{
+	for(std::size_t i = N; i-- > 0;)
+	{
+		if(l[i] != r[i])
+		{
+			return l[i] <=> r[i];
+		}
+	}
+	return std::strong_ordering::equal;
+}
+
+}
+
+namespace uint128 {
+typedef BigInteger<uint64_t,false,0,1> uint128_t;
+
+/// literal operator
+template<char ...digits>
+constexpr uint128_t operator "" _num() noexcept
+{
+	return uint128_t::to_number<digits...>();
+}
+}
+
+namespace uint256 {
+typedef BigInteger<__uint128_t,false,0,1> uint256_t;
+
+/// literal operator
+template<char ...digits>
+constexpr uint256_t operator "" _num() noexcept
+{
+	return uint256_t::to_number<digits...>();
+}
+}
+
+namespace uint512 {
 typedef BigInteger<__uint128_t,false,0,1,2,3> uint512_t;
 
 /// literal operator
@@ -651,11 +1775,134 @@ constexpr uint1024_t operator "" _num() noexcept
 }
 }
 
+namespace uint192 {
+typedef BigInt<192,false> uint192_t;
+
+/// literal operator
+template<char ...digits>
+constexpr uint192_t operator "" _num() noexcept
+{
+	return uint192_t::to_number<digits...>();
+}
+}
+
+namespace int192 {
+typedef BigInt<192,true> int192_t;
+
+/// literal operator
+template<char ...digits>
+constexpr int192_t operator "" _num() noexcept
+{
+	return int192_t::to_number<digits...>();
+}
+}
+
+namespace uint384 {
+typedef BigInt<384,false> uint384_t;
+
+/// literal operator
+template<char ...digits>
+constexpr uint384_t operator "" _num() noexcept
+{
+	return uint384_t::to_number<digits...>();
+}
+}
+
+namespace int384 {
+typedef BigInt<384,true> int384_t;
+
+/// literal operator
+template<char ...digits>
+constexpr int384_t operator "" _num() noexcept
+{
+	return int384_t::to_number<digits...>();
+}
+}
+
+namespace uint2048 {
+typedef BigInt<2048,false> uint2048_t;
+
+/// literal operator
+template<char ...digits>
+constexpr uint2048_t operator "" _num() noexcept
+{
+	return uint2048_t::to_number<digits...>();
+}
+}
+
+namespace int2048 {
+typedef BigInt<2048,true> int2048_t;
+
+/// literal operator
+template<char ...digits>
+constexpr int2048_t operator "" _num() noexcept
+{
+	return int2048_t::to_number<digits...>();
+}
+}
+
+namespace uint4096 {
+typedef BigInt<4096,false> uint4096_t;
+
+/// literal operator
+template<char ...digits>
+constexpr uint4096_t operator "" _num() noexcept
+{
+	return uint4096_t::to_number<digits...>();
+}
+}
+
+namespace int4096 {
+typedef BigInt<4096,true> int4096_t;
+
+/// literal operator
+template<char ...digits>
+constexpr int4096_t operator "" _num() noexcept
+{
+	return int4096_t::to_number<digits...>();
+}
+}
+
+/// 64 bit limb layouts of the 128 bit limb widths
+using uint256_64_t = BigInt<256,false,uint64_t>;
+using uint384_64_t = BigInt<384,false,uint64_t>;
+using int384_64_t = BigInt<384,true,uint64_t>;
+using uint512_64_t = BigInt<512,false,uint64_t>;
+using int512_64_t = BigInt<512,true,uint64_t>;
+using uint1024_64_t = BigInt<1024,false,uint64_t>;
+using uint2048_64_t = BigInt<2048,false,uint64_t>;
+using int2048_64_t = BigInt<2048,true,uint64_t>;
+using uint4096_64_t = BigInt<4096,false,uint64_t>;
+using int4096_64_t = BigInt<4096,true,uint64_t>;
+
 using uint128_t = uint128::uint128_t;
 using uint256_t = uint256::uint256_t;
 using uint512_t = uint512::uint512_t;
 using int512_t = int512::int512_t;
 using uint1024_t = uint1024::uint1024_t;
+using uint192_t = uint192::uint192_t;
+using int192_t = int192::int192_t;
+using uint384_t = uint384::uint384_t;
+using int384_t = int384::int384_t;
+using uint2048_t = uint2048::uint2048_t;
+using int2048_t = int2048::int2048_t;
+using uint4096_t = uint4096::uint4096_t;
+using int4096_t = int4096::int4096_t;
+
+#ifndef BIGINTEGER_HEADER_ONLY
+/// Instantiated once in biginteger.cpp, define BIGINTEGER_HEADER_ONLY to use the header without the library
+extern template class BigInteger<uint64_t,false,0,1>;
+extern template class BigInteger<__uint128_t,false,0,1>;
+extern template class BigInteger<__uint128_t,false,0,1,2,3>;
+extern template class BigInteger<__uint128_t,true,0,1,2,3>;
+extern template class BigInteger<__uint128_t,false,0,1,2,3,4,5,6,7>;
+#endif
+
+/// Plain arrays of blocks, containers and algorithms may relocate them with memcpy
+static_assert(std::is_trivially_copyable_v<uint128_t> && std::is_trivially_copyable_v<uint256_t> &&
+			  std::is_trivially_copyable_v<uint512_t> && std::is_trivially_copyable_v<int512_t> &&
+			  std::is_trivially_copyable_v<uint1024_t> && std::is_trivially_copyable_v<uint4096_64_t>,
+			  "BigInteger must be trivially copyable");
 
 }
 
@@ -664,6 +1911,33 @@ template <>
 struct is_integral<biginteger::int512_t> : std::true_type {};
 template <>
 struct is_integral<biginteger::uint512_t> : std::true_type {};
+
+/// wyhash style hash, two words are folded per 64x64->128 bit multiply
+template<std::unsigned_integral B, bool is_signed, std::size_t ...I>
+struct hash<biginteger::BigInteger<B,is_signed,I...>>
+{
+	constexpr std::size_t operator()(const biginteger::BigInteger<B,is_signed,I...> & n) const noexcept
+	{
+		constexpr uint64_t secret[4] = {0xa0761d6478bd642fu, 0xe7037ed1a0b428dbu, 0x8ebc6af09c88c6e3u, 0x589965cc75374cc3u};
+		/// multiply and fold high and low half
+		auto mix = [](uint64_t l, uint64_t r) {
+			const __uint128_t product = __uint128_t(l) * r;
+			return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+		};
+		const auto words = n.to_words();
+		uint64_t seed = secret[0];
+		std::size_t i = 0;
+		for(; i + 1 < words.size(); i += 2)
+		{
+			seed = mix(words[i] ^ secret[1], words[i+1] ^ seed);
+		}
+		if(i < words.size())
+		{
+			seed = mix(words[i] ^ secret[1], seed ^ secret[2]);
+		}
+		return mix(seed ^ secret[3], (words.size() * 8) ^ secret[1]);
+	}
+};
 }
 
 #endif // BIGINTEGER_H
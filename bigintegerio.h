@@ -0,0 +1,49 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BIGINTEGERIO_H
+#define BIGINTEGERIO_H
+
+#include <iomanip>
+#include <iostream>
+
+#include "biginteger.h"
+
+namespace biginteger {
+
+inline std::ostream & operator<<(std::ostream & stream, const __uint128_t & r)
+{
+	uint64_t l = static_cast<uint64_t>(r);
+	uint64_t u = r>>64;
+	if(u > 0)
+		return stream<<std::showbase<<u<<std::noshowbase<<std::setfill('0')<<std::setw(16)<<l<<std::showbase;
+	else
+		return stream<<std::showbase<<l;
+
+}
+
+/// Blocks in hex, least significant first
+template<std::unsigned_integral B, bool is_signed, std::size_t ...I>
+std::ostream & operator<<(std::ostream & stream, const BigInteger<B,is_signed,I...> & r)
+{
+	const auto & blocks = r.blocks();
+	return (stream<<"[ ",((stream << std::hex << (blocks[I]) << (I < blocks.size()-1 ? ", ":" ")), ...),stream<<"]");
+}
+
+}
+
+#endif // BIGINTEGERIO_H
@@ -0,0 +1,195 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BIGINTEGERVIEW_H
+#define BIGINTEGERVIEW_H
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+#include "biginteger.h"
+
+/// Non owning access to values of a BigInteger type stored in external memory such as
+/// network buffers, memory mappings or columns of words. The storage may be unaligned and
+/// in either byte order, Order is the order of the whole value: big endian puts the most
+/// significant byte first. Loads and stores go through memcpy and a byte swap per word.
+///
+/// Views convert to T, and T is an associated class of the view types, so the operators
+/// of T apply to views and references directly and return T. BigIntegerRef adds
+/// assignment and the compound operators, which write the result back in place.
+namespace biginteger {
+
+namespace detail {
+
+constexpr uint64_t byteswap64(uint64_t w)
+{
+	return __builtin_bswap64(w);
+}
+
+template<big_integer T, std::endian Order>
+T load(const std::byte * data)
+{
+	constexpr std::size_t N = T::word_count;
+	std::array<uint64_t,N> words;
+	for(std::size_t i = 0; i < N; i++)
+	{
+		uint64_t w;
+		std::memcpy(&w, data + 8 * (Order == std::endian::little ? i : N - 1 - i), sizeof(w));
+		words[i] = Order == std::endian::native ? w : byteswap64(w);
+	}
+	return T::from_words(words);
+}
+
+template<big_integer T, std::endian Order>
+void store(std::byte * data, const T & value)
+{
+	constexpr std::size_t N = T::word_count;
+	const auto words = value.to_words();
+	for(std::size_t i = 0; i < N; i++)
+	{
+		const uint64_t w = Order == std::endian::native ? words[i] : byteswap64(words[i]);
+		std::memcpy(data + 8 * (Order == std::endian::little ? i : N - 1 - i), &w, sizeof(w));
+	}
+}
+
+}
+
+/// Read only view of a T at an external address
+template<big_integer T, std::endian Order = std::endian::little>
+class BigIntegerView
+{
+public:
+	using value_type = T;
+
+	/// Bytes of a stored value
+	static constexpr std::size_t size = T::bit_size / 8;
+
+	explicit BigIntegerView(const void * data)
+		: data(static_cast<const std::byte *>(data))
+	{}
+
+	T load() const
+	{
+		return detail::load<T,Order>(data);
+	}
+
+	operator T() const
+	{
+		return load();
+	}
+
+	const void * address() const
+	{
+		return data;
+	}
+
+private:
+	const std::byte * data;
+};
+
+/// Mutable reference to a T at an external address. Assignment stores the value, it does
+/// not rebind the reference.
+template<big_integer T, std::endian Order = std::endian::little>
+class BigIntegerRef
+{
+public:
+	using value_type = T;
+
+	static constexpr std::size_t size = T::bit_size / 8;
+
+	explicit BigIntegerRef(void * data)
+		: data(static_cast<std::byte *>(data))
+	{}
+
+	BigIntegerRef(const BigIntegerRef & other) = default;
+
+	T load() const
+	{
+		return detail::load<T,Order>(data);
+	}
+
+	void store(const T & value) const
+	{
+		detail::store<T,Order>(data, value);
+	}
+
+	operator T() const
+	{
+		return load();
+	}
+
+	operator BigIntegerView<T,Order>() const
+	{
+		return BigIntegerView<T,Order>(data);
+	}
+
+	void * address() const
+	{
+		return data;
+	}
+
+	const BigIntegerRef & operator=(const T & value) const
+	{
+		store(value);
+		return *this;
+	}
+
+	const BigIntegerRef & operator=(const BigIntegerRef & other) const
+	{
+		store(other.load());
+		return *this;
+	}
+
+#define BIGINTEGER_REF_ASSIGNMENT(op) \
+	template<typename R> \
+	const BigIntegerRef & operator op##=(const R & r) const \
+	{ \
+		store(load() op r); \
+		return *this; \
+	}
+
+	BIGINTEGER_REF_ASSIGNMENT(+)
+	BIGINTEGER_REF_ASSIGNMENT(-)
+	BIGINTEGER_REF_ASSIGNMENT(*)
+	BIGINTEGER_REF_ASSIGNMENT(/)
+	BIGINTEGER_REF_ASSIGNMENT(%)
+	BIGINTEGER_REF_ASSIGNMENT(&)
+	BIGINTEGER_REF_ASSIGNMENT(|)
+	BIGINTEGER_REF_ASSIGNMENT(^)
+	BIGINTEGER_REF_ASSIGNMENT(<<)
+	BIGINTEGER_REF_ASSIGNMENT(>>)
+
+#undef BIGINTEGER_REF_ASSIGNMENT
+
+	const BigIntegerRef & operator++() const
+	{
+		return *this += T(1u);
+	}
+
+	const BigIntegerRef & operator--() const
+	{
+		return *this -= T(1u);
+	}
+
+private:
+	std::byte * data;
+};
+
+}
+
+#endif // BIGINTEGERVIEW_H
@@ -0,0 +1,190 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "columnfile.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace biginteger {
+
+namespace {
+
+[[noreturn]] void system_error(const std::string & what)
+{
+	throw std::system_error(errno, std::generic_category(), what);
+}
+
+constexpr uint64_t align64(uint64_t offset)
+{
+	return (offset + 63) & ~uint64_t(63);
+}
+
+}
+
+void ColumnFileWriter::write(const std::string & path) const
+{
+	if constexpr(std::endian::native != std::endian::little)
+	{
+		detail::invalid_argument("Column files need a little endian machine!");
+	}
+	detail::column_file_header header{};
+	std::memcpy(header.magic, detail::column_file_magic, sizeof(header.magic));
+	header.version = detail::column_file_version;
+	header.columns = static_cast<uint32_t>(columns.size());
+	header.rows = rows;
+
+	std::vector<detail::column_entry> entries(columns.size());
+	uint64_t offset = align64(sizeof(header) + entries.size() * sizeof(detail::column_entry));
+	for(std::size_t i = 0; i < columns.size(); i++)
+	{
+		entries[i] = {columns[i].bits, columns[i].flags, offset, 0, 0};
+		offset = align64(offset + rows * (columns[i].bits / 8));
+	}
+	for(std::size_t i = 0; i < columns.size(); i++)
+	{
+		if(!columns[i].min.empty())
+		{
+			entries[i].min = offset;
+			entries[i].max = offset + columns[i].min.size();
+			offset += 2 * columns[i].min.size();
+		}
+	}
+
+	std::FILE * file = std::fopen(path.c_str(), "wb");
+	if(!file)
+	{
+		system_error("Cannot create " + path);
+	}
+	uint64_t written = 0;
+	bool ok = true;
+	auto put = [&](const void * data, std::size_t bytes) {
+		ok = ok && std::fwrite(data, 1, bytes, file) == bytes;
+		written += bytes;
+	};
+	auto pad = [&](uint64_t to) {
+		static constexpr char zeros[64] = {};
+		put(zeros, to - written);
+	};
+	put(&header, sizeof(header));
+	put(entries.data(), entries.size() * sizeof(detail::column_entry));
+	for(std::size_t i = 0; i < columns.size(); i++)
+	{
+		pad(entries[i].data);
+		put(columns[i].data, rows * (columns[i].bits / 8));
+	}
+	for(std::size_t i = 0; i < columns.size(); i++)
+	{
+		if(entries[i].min)
+		{
+			pad(entries[i].min);
+			put(columns[i].min.data(), columns[i].min.size());
+			put(columns[i].max.data(), columns[i].max.size());
+		}
+	}
+	ok = std::fclose(file) == 0 && ok;
+	if(!ok)
+	{
+		system_error("Cannot write " + path);
+	}
+}
+
+ColumnFile::ColumnFile(const std::string & path)
+{
+	if constexpr(std::endian::native != std::endian::little)
+	{
+		detail::invalid_argument("Column files need a little endian machine!");
+	}
+	const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0)
+	{
+		system_error("Cannot open " + path);
+	}
+	struct stat info;
+	if(::fstat(fd, &info) != 0)
+	{
+		::close(fd);
+		system_error("Cannot stat " + path);
+	}
+	size = static_cast<std::size_t>(info.st_size);
+	if(size < sizeof(detail::column_file_header))
+	{
+		::close(fd);
+		detail::invalid_argument("Not a column file!");
+	}
+	void * mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if(mapping == MAP_FAILED)
+	{
+		system_error("Cannot map " + path);
+	}
+	base = static_cast<const std::byte *>(mapping);
+
+	/// validate every offset once, the accessors trust them afterwards
+	const detail::column_file_header & h = header();
+	bool valid = std::memcmp(h.magic, detail::column_file_magic, sizeof(h.magic)) == 0 && h.version == detail::column_file_version &&
+			size >= sizeof(h) + uint64_t(h.columns) * sizeof(detail::column_entry);
+	for(std::size_t i = 0; valid && i < h.columns; i++)
+	{
+		const detail::column_entry & e = entry(i);
+		const uint64_t bytes = e.bits / 8;
+		valid = e.bits % 64 == 0 && e.bits && e.data % 64 == 0 && e.data <= size && h.rows <= (size - e.data) / bytes &&
+				(!e.min || (e.min <= size && e.max <= size && size - e.min >= bytes && size - e.max >= bytes));
+	}
+	if(!valid)
+	{
+		::munmap(const_cast<std::byte *>(base), size);
+		base = nullptr;
+		detail::invalid_argument("Not a column file!");
+	}
+}
+
+ColumnFile::ColumnFile(ColumnFile && other) noexcept
+	: base(std::exchange(other.base, nullptr)), size(std::exchange(other.size, 0))
+{
+}
+
+ColumnFile & ColumnFile::operator=(ColumnFile && other) noexcept
+{
+	if(this != &other)
+	{
+		if(base)
+		{
+			::munmap(const_cast<std::byte *>(base), size);
+		}
+		base = std::exchange(other.base, nullptr);
+		size = std::exchange(other.size, 0);
+	}
+	return *this;
+}
+
+ColumnFile::~ColumnFile()
+{
+	if(base)
+	{
+		::munmap(const_cast<std::byte *>(base), size);
+	}
+}
+
+}
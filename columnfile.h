@@ -0,0 +1,196 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLUMNFILE_H
+#define COLUMNFILE_H
+
+#include <optional>
+#include <string>
+
+#include "biginteger.h"
+
+/// Column files: fixed width BigInteger arrays on disk that are memory mapped and used in
+/// place, without parsing or copying.
+///
+/// Layout, all numbers little endian:
+///   header      magic "BIGICOLS", uint32 version, uint32 columns, uint64 rows, uint64 0
+///   directory   per column uint32 bits, uint32 flags, uint64 data, min and max offset
+///   columns     rows values of bits / 8 bytes each, every column 64 byte aligned
+///   statistics  optional min and max value of a column, offset 0 if absent
+/// The values are stored in the in memory layout of the BigInteger types, which is the
+/// little endian byte order of the value on little endian machines.
+namespace biginteger {
+
+namespace detail {
+
+inline constexpr char column_file_magic[8] = {'B', 'I', 'G', 'I', 'C', 'O', 'L', 'S'};
+inline constexpr uint32_t column_file_version = 1;
+inline constexpr uint32_t column_signed = 1;
+
+struct column_file_header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t columns;
+	uint64_t rows;
+	uint64_t reserved;
+};
+
+struct column_entry
+{
+	uint32_t bits;
+	uint32_t flags;
+	uint64_t data;
+	uint64_t min;
+	uint64_t max;
+};
+
+template<big_integer T>
+constexpr uint32_t column_flags()
+{
+	return T(0u) > ~T(0u) ? column_signed : 0;
+}
+
+}
+
+/// Collects equally long columns and writes them to a column file.
+/// The spans are not copied, they have to stay valid until write().
+class ColumnFileWriter
+{
+public:
+	/// Append a column, with its min and max value stored for skipping if min_max is set
+	template<big_integer T>
+	void add(std::span<const T> values, bool min_max = true)
+	{
+		if(!columns.empty() && values.size() != rows)
+		{
+			detail::invalid_argument("Columns must have the same length!");
+		}
+		rows = values.size();
+		Column column{T::bit_size, detail::column_flags<T>(), reinterpret_cast<const std::byte *>(values.data()), {}, {}};
+		if(min_max && !values.empty())
+		{
+			const T lo = min(values);
+			const T hi = max(values);
+			column.min.resize(sizeof(T));
+			column.max.resize(sizeof(T));
+			std::memcpy(column.min.data(), &lo, sizeof(T));
+			std::memcpy(column.max.data(), &hi, sizeof(T));
+		}
+		columns.push_back(std::move(column));
+	}
+
+	/// Write the file, throws std::system_error if it cannot be written
+	void write(const std::string & path) const;
+
+private:
+	struct Column
+	{
+		uint32_t bits;
+		uint32_t flags;
+		const std::byte * data;
+		std::vector<std::byte> min;
+		std::vector<std::byte> max;
+	};
+
+	std::vector<Column> columns;
+	std::size_t rows = 0;
+};
+
+/// Read only memory mapping of a column file, the columns are views into the mapping.
+/// Throws std::system_error if the file cannot be mapped and std::invalid_argument if it
+/// is not a column file of this version.
+class ColumnFile
+{
+public:
+	explicit ColumnFile(const std::string & path);
+	ColumnFile(ColumnFile && other) noexcept;
+	ColumnFile & operator=(ColumnFile && other) noexcept;
+	~ColumnFile();
+
+	std::size_t rows() const
+	{
+		return header().rows;
+	}
+
+	std::size_t columns() const
+	{
+		return header().columns;
+	}
+
+	/// Bit width of the values of column i
+	std::size_t bits(std::size_t i) const
+	{
+		return entry(i).bits;
+	}
+
+	/// Values of column i, T has to match the width and signedness the column was written with
+	template<big_integer T>
+	std::span<const T> column(std::size_t i) const
+	{
+		check_type<T>(i);
+		return {reinterpret_cast<const T *>(base + entry(i).data), rows()};
+	}
+
+	/// Smallest and largest value of column i, if they were written
+	template<big_integer T>
+	std::optional<std::pair<T,T>> min_max(std::size_t i) const
+	{
+		check_type<T>(i);
+		const detail::column_entry & e = entry(i);
+		if(!e.min)
+		{
+			return std::nullopt;
+		}
+		std::pair<T,T> result;
+		std::memcpy(&result.first, base + e.min, sizeof(T));
+		std::memcpy(&result.second, base + e.max, sizeof(T));
+		return result;
+	}
+
+private:
+	const detail::column_file_header & header() const
+	{
+		return *reinterpret_cast<const detail::column_file_header *>(base);
+	}
+
+	const detail::column_entry & entry(std::size_t i) const
+	{
+		if(i >= columns())
+		{
+			detail::invalid_argument("Column index out of range!");
+		}
+		return reinterpret_cast<const detail::column_entry *>(base + sizeof(detail::column_file_header))[i];
+	}
+
+	template<big_integer T>
+	void check_type(std::size_t i) const
+	{
+		const detail::column_entry & e = entry(i);
+		if(e.bits != T::bit_size || e.flags != detail::column_flags<T>())
+		{
+			detail::invalid_argument("Column type mismatch!");
+		}
+	}
+
+	const std::byte * base = nullptr;
+	std::size_t size = 0;
+};
+
+}
+
+#endif // COLUMNFILE_H
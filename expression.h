@@ -0,0 +1,327 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include "biginteger.h"
+
+/// Opt-in lazy arithmetic: lazy(a) * b + c builds an expression tree which is
+/// evaluated on assignment, multiply-add, multiply-add-subtract, add-sub and
+/// shift-or are fused into single pass kernels. Leaves are held by reference, so an expression must be
+/// evaluated within the full expression that created it.
+namespace biginteger::expression {
+
+/// Leaf, reference to an operand
+template<big_integer T>
+struct Value
+{
+	using value_type = T;
+	const T & value;
+};
+
+struct Plus {};
+struct Minus {};
+struct Multiply {};
+struct Or {};
+struct And {};
+struct Xor {};
+
+template<typename Op, typename L, typename R>
+struct Binary
+{
+	using value_type = typename L::value_type;
+	L l;
+	R r;
+
+	constexpr operator value_type() const;
+};
+
+template<typename L, std::unsigned_integral S>
+struct ShiftLeft
+{
+	using value_type = typename L::value_type;
+	L l;
+	S n;
+
+	constexpr operator value_type() const;
+};
+
+template<typename L, std::unsigned_integral S>
+struct ShiftRight
+{
+	using value_type = typename L::value_type;
+	L l;
+	S n;
+
+	constexpr operator value_type() const;
+};
+
+template<typename T>
+struct is_node : std::false_type {};
+
+template<typename T>
+struct is_node<Value<T>> : std::true_type {};
+
+template<typename Op, typename L, typename R>
+struct is_node<Binary<Op, L, R>> : std::true_type {};
+
+template<typename L, typename S>
+struct is_node<ShiftLeft<L, S>> : std::true_type {};
+
+template<typename L, typename S>
+struct is_node<ShiftRight<L, S>> : std::true_type {};
+
+template<typename T>
+concept node = is_node<T>::value;
+
+template<typename T>
+struct is_value : std::false_type {};
+
+template<typename T>
+struct is_value<Value<T>> : std::true_type {};
+
+template<typename T, typename Op>
+struct is_binary : std::false_type {};
+
+template<typename Op, typename L, typename R>
+struct is_binary<Binary<Op, L, R>, Op> : std::true_type {};
+
+template<typename T>
+struct is_shift_left : std::false_type {};
+
+template<typename L, typename S>
+struct is_shift_left<ShiftLeft<L, S>> : std::true_type {};
+
+/// Kernel which evaluates a node in one pass
+enum class fusion { none, mul_add, mul_add_sub, add_sub, shl_or };
+
+template<typename T>
+struct fused
+{
+	static constexpr fusion value = fusion::none;
+};
+
+/// a * b + c, a * b + c - d, a * b - d, a + b - c and (a << n) | b, commuted where the
+/// operation allows it
+template<typename Op, typename L, typename R>
+struct fused<Binary<Op, L, R>>
+{
+	static constexpr fusion value =
+		std::is_same_v<Op, Plus> && (is_binary<L, Multiply>::value || is_binary<R, Multiply>::value) ? fusion::mul_add :
+		std::is_same_v<Op, Minus> && (is_binary<L, Multiply>::value || fused<L>::value == fusion::mul_add) ? fusion::mul_add_sub :
+		std::is_same_v<Op, Minus> && is_binary<L, Plus>::value ? fusion::add_sub :
+		std::is_same_v<Op, Or> && (is_shift_left<L>::value || is_shift_left<R>::value) ? fusion::shl_or :
+		fusion::none;
+};
+
+/// Start a lazy expression
+template<big_integer T>
+constexpr Value<T> lazy(const T & value)
+{
+	return {value};
+}
+
+template<node E>
+constexpr typename E::value_type evaluate(const E & e);
+
+/// Leaves are passed by reference, inner nodes are evaluated
+template<node E>
+constexpr decltype(auto) operand(const E & e)
+{
+	if constexpr(is_value<E>::value)
+	{
+		return (e.value);
+	}
+	else
+	{
+		return evaluate(e);
+	}
+}
+
+template<typename Op, typename L, typename R>
+constexpr typename L::value_type evaluate_binary(const Binary<Op, L, R> & e)
+{
+	using T = typename L::value_type;
+	constexpr fusion kernel = fused<Binary<Op, L, R>>::value;
+	if constexpr(kernel == fusion::mul_add)
+	{
+		if constexpr(is_binary<L, Multiply>::value)
+		{
+			return T::mul_add(operand(e.l.l), operand(e.l.r), operand(e.r));
+		}
+		else
+		{
+			return T::mul_add(operand(e.r.l), operand(e.r.r), operand(e.l));
+		}
+	}
+	else if constexpr(kernel == fusion::mul_add_sub)
+	{
+		if constexpr(is_binary<L, Multiply>::value)
+		{
+			return T::mul_add_sub(operand(e.l.l), operand(e.l.r), T(0u), operand(e.r));
+		}
+		else if constexpr(is_binary<decltype(e.l.l), Multiply>::value)
+		{
+			return T::mul_add_sub(operand(e.l.l.l), operand(e.l.l.r), operand(e.l.r), operand(e.r));
+		}
+		else
+		{
+			return T::mul_add_sub(operand(e.l.r.l), operand(e.l.r.r), operand(e.l.l), operand(e.r));
+		}
+	}
+	else if constexpr(kernel == fusion::add_sub)
+	{
+		return T::add_sub(operand(e.l.l), operand(e.l.r), operand(e.r));
+	}
+	else if constexpr(kernel == fusion::shl_or)
+	{
+		if constexpr(is_shift_left<L>::value)
+		{
+			return T::shl_or(operand(e.l.l), e.l.n, operand(e.r));
+		}
+		else
+		{
+			return T::shl_or(operand(e.r.l), e.r.n, operand(e.l));
+		}
+	}
+	else
+	{
+		T result(operand(e.l));
+		if constexpr(std::is_same_v<Op, Plus>)
+		{
+			result += operand(e.r);
+		}
+		else if constexpr(std::is_same_v<Op, Minus>)
+		{
+			result -= operand(e.r);
+		}
+		else if constexpr(std::is_same_v<Op, Multiply>)
+		{
+			result *= operand(e.r);
+		}
+		else if constexpr(std::is_same_v<Op, Or>)
+		{
+			result |= operand(e.r);
+		}
+		else if constexpr(std::is_same_v<Op, And>)
+		{
+			result &= operand(e.r);
+		}
+		else
+		{
+			result ^= operand(e.r);
+		}
+		return result;
+	}
+}
+
+/// Evaluate an expression tree
+template<node E>
+constexpr typename E::value_type evaluate(const E & e)
+{
+	if constexpr(is_value<E>::value)
+	{
+		return typename E::value_type(e.value);
+	}
+	else if constexpr(is_shift_left<E>::value)
+	{
+		return operand(e.l) << e.n;
+	}
+	else if constexpr(requires { e.n; })
+	{
+		return operand(e.l) >> e.n;
+	}
+	else
+	{
+		return evaluate_binary(e);
+	}
+}
+
+/// Evaluate an expression tree into dest
+template<node E>
+constexpr typename E::value_type & assign(typename E::value_type & dest, const E & e)
+{
+	return dest = evaluate(e);
+}
+
+template<typename Op, typename L, typename R>
+constexpr Binary<Op, L, R>::operator value_type() const
+{
+	return evaluate(*this);
+}
+
+template<typename L, std::unsigned_integral S>
+constexpr ShiftLeft<L, S>::operator value_type() const
+{
+	return evaluate(*this);
+}
+
+template<typename L, std::unsigned_integral S>
+constexpr ShiftRight<L, S>::operator value_type() const
+{
+	return evaluate(*this);
+}
+
+#define BIGINTEGER_EXPRESSION_OPERATOR(op, Op) \
+template<node L, node R> \
+	requires std::is_same_v<typename L::value_type, typename R::value_type> \
+constexpr Binary<Op, L, R> operator op(const L & l, const R & r) \
+{ \
+	return {l, r}; \
+} \
+template<node L> \
+constexpr Binary<Op, L, Value<typename L::value_type>> operator op(const L & l, const std::type_identity_t<typename L::value_type> & r) \
+{ \
+	return {l, {r}}; \
+} \
+template<node R> \
+constexpr Binary<Op, Value<typename R::value_type>, R> operator op(const std::type_identity_t<typename R::value_type> & l, const R & r) \
+{ \
+	return {{l}, r}; \
+}
+
+BIGINTEGER_EXPRESSION_OPERATOR(+, Plus)
+BIGINTEGER_EXPRESSION_OPERATOR(-, Minus)
+BIGINTEGER_EXPRESSION_OPERATOR(*, Multiply)
+BIGINTEGER_EXPRESSION_OPERATOR(|, Or)
+BIGINTEGER_EXPRESSION_OPERATOR(&, And)
+BIGINTEGER_EXPRESSION_OPERATOR(^, Xor)
+
+#undef BIGINTEGER_EXPRESSION_OPERATOR
+
+template<node L, std::unsigned_integral S>
+constexpr ShiftLeft<L, S> operator<<(const L & l, const S & n)
+{
+	return {l, n};
+}
+
+template<node L, std::unsigned_integral S>
+constexpr ShiftRight<L, S> operator>>(const L & l, const S & n)
+{
+	return {l, n};
+}
+
+}
+
+namespace biginteger {
+
+using expression::lazy;
+
+}
+
+#endif // EXPRESSION_H
@@ -0,0 +1,804 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "kernels.h"
+#include "biginteger.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+/// _mm512_undefined_epi32 initializes a variable with itself, GCC 12 warns once set1 is inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#endif
+
+namespace biginteger::kernels {
+
+namespace {
+
+/// Plain cpuid and xgetbv, usable from ifunc resolvers before relocations are done
+inline cpu_features detect() noexcept
+{
+	cpu_features features;
+#if defined(__x86_64__)
+	unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+	{
+		return features;
+	}
+	features.pclmulqdq = ecx & bit_PCLMUL;
+	bool avx_state = false;
+	bool avx512_state = false;
+	if(ecx & bit_OSXSAVE)
+	{
+		unsigned xcr0_lo = 0, xcr0_hi = 0;
+		__asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+		/// xmm and ymm state, then opmask and zmm state
+		avx_state = (xcr0_lo & 0x6) == 0x6;
+		avx512_state = avx_state && (xcr0_lo & 0xe0) == 0xe0;
+	}
+	if(__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+	{
+		features.bmi2 = ebx & bit_BMI2;
+		features.adx = ebx & bit_ADX;
+		features.avx2 = avx_state && (ebx & bit_AVX2);
+		features.avx512f = avx512_state && (ebx & bit_AVX512F);
+		features.avx512ifma = avx512_state && (ebx & bit_AVX512F) && (ebx & bit_AVX512IFMA);
+		features.vpclmulqdq = avx_state && (ecx & bit_VPCLMULQDQ);
+	}
+#endif
+	return features;
+}
+
+}
+
+const cpu_features & cpu() noexcept
+{
+	static const cpu_features features = detect();
+	return features;
+}
+
+namespace generic {
+
+void mul_add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; i++)
+	{
+		uint64_t carry = 0;
+		for(std::size_t j = 0; i + j < n; j++)
+		{
+			const __uint128_t p = __uint128_t(a[i]) * b[j] + r[i+j] + carry;
+			r[i+j] = static_cast<uint64_t>(p);
+			carry = static_cast<uint64_t>(p >> 64);
+		}
+	}
+}
+
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	uint64_t carry = 0;
+	for(std::size_t i = 0; i < n; i++)
+	{
+		const uint64_t temp = a[i] + carry;
+		carry = temp < carry;
+		r[i] = temp + b[i];
+		carry |= r[i] < temp;
+	}
+	return carry;
+}
+
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	uint64_t borrow = 0;
+	for(std::size_t i = 0; i < n; i++)
+	{
+		const uint64_t temp = a[i] - borrow;
+		borrow = temp > a[i];
+		r[i] = temp - b[i];
+		borrow |= r[i] > temp;
+	}
+	return borrow;
+}
+
+void add_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept
+{
+	for(std::size_t k = 0; k < count * n; k += n)
+	{
+		add(r + k, a + k, b + k, n);
+	}
+}
+
+void sub_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept
+{
+	for(std::size_t k = 0; k < count * n; k += n)
+	{
+		sub(r + k, a + k, b + k, n);
+	}
+}
+
+/// Coarsely integrated operand scanning, one word of b per round
+void montgomery_mul_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, const uint64_t * m, uint64_t m_inv, std::size_t n, std::size_t count) noexcept
+{
+	if(n > montgomery_max_words)
+	{
+		std::abort();
+	}
+	uint64_t t[montgomery_max_words + 2];
+	for(std::size_t k = 0; k < count * n; k += n)
+	{
+		std::fill(t, t + n + 2, 0);
+		for(std::size_t i = 0; i < n; i++)
+		{
+			uint64_t carry = 0;
+			for(std::size_t j = 0; j < n; j++)
+			{
+				__uint128_t sum = __uint128_t(a[k+j]) * b[k+i] + t[j] + carry;
+				t[j] = static_cast<uint64_t>(sum);
+				carry = static_cast<uint64_t>(sum >> 64);
+			}
+			__uint128_t sum = __uint128_t(t[n]) + carry;
+			t[n] = static_cast<uint64_t>(sum);
+			t[n+1] = static_cast<uint64_t>(sum >> 64);
+
+			const uint64_t q = t[0] * m_inv;
+			sum = __uint128_t(q) * m[0] + t[0];
+			carry = static_cast<uint64_t>(sum >> 64);
+			for(std::size_t j = 1; j < n; j++)
+			{
+				sum = __uint128_t(q) * m[j] + t[j] + carry;
+				t[j-1] = static_cast<uint64_t>(sum);
+				carry = static_cast<uint64_t>(sum >> 64);
+			}
+			sum = __uint128_t(t[n]) + carry;
+			t[n-1] = static_cast<uint64_t>(sum);
+			t[n] = t[n+1] + static_cast<uint64_t>(sum >> 64);
+		}
+		/// t < 2 m, subtract m once if t >= m
+		uint64_t borrow = 0;
+		for(std::size_t j = 0; j < n; j++)
+		{
+			r[k+j] = t[j] - m[j] - borrow;
+			borrow = t[j] < m[j] || (t[j] == m[j] && borrow);
+		}
+		if(borrow && !t[n])
+		{
+			std::copy(t, t + n, r + k);
+		}
+	}
+}
+
+void clmul(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	std::fill(r, r + 2 * n, 0);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		for(std::size_t j = 0; j < n; j++)
+		{
+			const auto [lo, hi] = detail::clmul_word(a[i], b[j]);
+			r[i+j] ^= lo;
+			r[i+j+1] ^= hi;
+		}
+	}
+}
+
+/// The most significant differing word decides, selected without branches
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept
+{
+	for(std::size_t k = 0; k < count; k++, a += n, b += n)
+	{
+		int8_t result = 0;
+		for(std::size_t j = 0; j + 1 < n; j++)
+		{
+			const int8_t c = (a[j] > b[j]) - (a[j] < b[j]);
+			result = c ? c : result;
+		}
+		const uint64_t flip = is_signed ? uint64_t(1) << 63 : 0;
+		const uint64_t x = a[n-1] ^ flip;
+		const uint64_t y = b[n-1] ^ flip;
+		const int8_t c = (x > y) - (x < y);
+		out[k] = c ? c : result;
+	}
+}
+
+}
+
+#if defined(__x86_64__)
+
+namespace adx {
+
+/// One row per word of a: mulx leaves the flags alone, adcx carries the low halves of the
+/// products and adox the high halves of the previous column. GCC merges the two chains of
+/// the intrinsics into one, so the row is written in assembly.
+__attribute__((target("bmi2,adx")))
+void mul_add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; i++)
+	{
+		uint64_t * row = r + i;
+		const uint64_t * column = b;
+		std::size_t quads = (n - i) / 4;
+		std::size_t rest = (n - i) % 4;
+		__asm__ volatile(
+			"xorl %%eax, %%eax\n\t"
+			"movq %[quads], %%rcx\n\t"
+			"1:\n\t"
+			"jrcxz 2f\n\t"
+			"mulx 0(%[column]), %%r8, %%r9\n\t"
+			"adcx 0(%[row]), %%r8\n\t"
+			"adox %%rax, %%r8\n\t"
+			"movq %%r8, 0(%[row])\n\t"
+			"movq %%r9, %%rax\n\t"
+			"mulx 8(%[column]), %%r8, %%r9\n\t"
+			"adcx 8(%[row]), %%r8\n\t"
+			"adox %%rax, %%r8\n\t"
+			"movq %%r8, 8(%[row])\n\t"
+			"movq %%r9, %%rax\n\t"
+			"mulx 16(%[column]), %%r8, %%r9\n\t"
+			"adcx 16(%[row]), %%r8\n\t"
+			"adox %%rax, %%r8\n\t"
+			"movq %%r8, 16(%[row])\n\t"
+			"movq %%r9, %%rax\n\t"
+			"mulx 24(%[column]), %%r8, %%r9\n\t"
+			"adcx 24(%[row]), %%r8\n\t"
+			"adox %%rax, %%r8\n\t"
+			"movq %%r8, 24(%[row])\n\t"
+			"movq %%r9, %%rax\n\t"
+			"leaq 32(%[column]), %[column]\n\t"
+			"leaq 32(%[row]), %[row]\n\t"
+			"leaq -1(%%rcx), %%rcx\n\t"
+			"jmp 1b\n\t"
+			"2:\n\t"
+			"movq %[rest], %%rcx\n\t"
+			"3:\n\t"
+			"jrcxz 4f\n\t"
+			"mulx 0(%[column]), %%r8, %%r9\n\t"
+			"adcx 0(%[row]), %%r8\n\t"
+			"adox %%rax, %%r8\n\t"
+			"movq %%r8, 0(%[row])\n\t"
+			"movq %%r9, %%rax\n\t"
+			"leaq 8(%[column]), %[column]\n\t"
+			"leaq 8(%[row]), %[row]\n\t"
+			"leaq -1(%%rcx), %%rcx\n\t"
+			"jmp 3b\n\t"
+			"4:"
+			: [row] "+r"(row), [column] "+r"(column)
+			: "d"(a[i]), [quads] "r"(quads), [rest] "r"(rest)
+			: "rax", "rcx", "r8", "r9", "cc", "memory");
+	}
+}
+
+__attribute__((target("adx")))
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	unsigned char carry = 0;
+	for(std::size_t i = 0; i < n; i++)
+	{
+		unsigned long long sum;
+		carry = _addcarryx_u64(carry, a[i], b[i], &sum);
+		r[i] = sum;
+	}
+	return carry;
+}
+
+__attribute__((target("adx")))
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	unsigned char borrow = 0;
+	for(std::size_t i = 0; i < n; i++)
+	{
+		unsigned long long diff;
+		borrow = _subborrow_u64(borrow, a[i], b[i], &diff);
+		r[i] = diff;
+	}
+	return borrow;
+}
+
+}
+
+namespace avx512 {
+
+namespace {
+
+/// Lanes receiving a carry: the generate lanes shifted up by one plus the carry in, rippled
+/// through the propagate lanes by one integer add. Generate and propagate exclude each other,
+/// so the bit above the last lane is the carry out.
+inline unsigned ripple(unsigned generate, unsigned propagate, unsigned lanes, unsigned & carry) noexcept
+{
+	const unsigned sum = ((generate << 1) | carry) + propagate;
+	carry = (sum >> lanes) & 1;
+	return sum ^ propagate;
+}
+
+/// Up to eight words, lanes above n are masked out
+template<bool subtract>
+__attribute__((target("avx512f")))
+inline void words8(uint64_t * r, const uint64_t * a, const uint64_t * b, unsigned n, unsigned & carry) noexcept
+{
+	const __mmask8 valid = static_cast<__mmask8>((1u << n) - 1);
+	const __m512i ones = _mm512_set1_epi64(-1);
+	const __m512i x = _mm512_maskz_loadu_epi64(valid, a);
+	const __m512i y = _mm512_maskz_loadu_epi64(valid, b);
+	if constexpr(subtract)
+	{
+		/// borrow generate x < y, propagate x - y == 0, x - y - 1 adds -1
+		__m512i d = _mm512_sub_epi64(x, y);
+		const unsigned in = ripple(_mm512_cmplt_epu64_mask(x, y), _mm512_mask_cmpeq_epi64_mask(valid, d, _mm512_setzero_si512()), n, carry);
+		d = _mm512_mask_add_epi64(d, static_cast<__mmask8>(in), d, ones);
+		_mm512_mask_storeu_epi64(r, valid, d);
+	}
+	else
+	{
+		/// carry generate s < x, propagate s == 2^64 - 1, s - (-1) adds 1
+		__m512i s = _mm512_add_epi64(x, y);
+		const unsigned in = ripple(_mm512_cmplt_epu64_mask(s, x), _mm512_mask_cmpeq_epi64_mask(valid, s, ones), n, carry);
+		s = _mm512_mask_sub_epi64(s, static_cast<__mmask8>(in), s, ones);
+		_mm512_mask_storeu_epi64(r, valid, s);
+	}
+}
+
+template<bool subtract>
+__attribute__((target("avx512f")))
+inline uint64_t words(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	unsigned carry = 0;
+	for(std::size_t i = 0; i < n; i += 8)
+	{
+		words8<subtract>(r + i, a + i, b + i, n - i < 8 ? unsigned(n - i) : 8u, carry);
+	}
+	return carry;
+}
+
+}
+
+__attribute__((target("avx512f")))
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	return words<false>(r, a, b, n);
+}
+
+__attribute__((target("avx512f")))
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	return words<true>(r, a, b, n);
+}
+
+__attribute__((target("avx512f")))
+void add_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept
+{
+	for(std::size_t k = 0; k < count * n; k += n)
+	{
+		words<false>(r + k, a + k, b + k, n);
+	}
+}
+
+__attribute__((target("avx512f")))
+void sub_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept
+{
+	for(std::size_t k = 0; k < count * n; k += n)
+	{
+		words<true>(r + k, a + k, b + k, n);
+	}
+}
+
+/// Greater and less masks of up to 64 words at a time, from the top. The two masks are
+/// disjoint, so the one with the higher set bit is also the larger integer.
+__attribute__((target("avx512f")))
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept
+{
+	const __m512i flip = _mm512_set1_epi64(int64_t(uint64_t(1) << 63));
+	if(n <= 8)
+	{
+		/// one register per value
+		const __mmask8 valid = static_cast<__mmask8>((1u << n) - 1);
+		const __mmask8 top = static_cast<__mmask8>(is_signed ? 1u << (n - 1) : 0);
+		for(std::size_t k = 0; k < count; k++, a += n, b += n)
+		{
+			__m512i x = _mm512_maskz_loadu_epi64(valid, a);
+			__m512i y = _mm512_maskz_loadu_epi64(valid, b);
+			x = _mm512_mask_xor_epi64(x, top, x, flip);
+			y = _mm512_mask_xor_epi64(y, top, y, flip);
+			const unsigned greater = _mm512_cmpgt_epu64_mask(x, y);
+			const unsigned less = _mm512_cmplt_epu64_mask(x, y);
+			out[k] = static_cast<int8_t>((greater > less) - (greater < less));
+		}
+		return;
+	}
+	for(std::size_t k = 0; k < count; k++, a += n, b += n)
+	{
+		int8_t result = 0;
+		for(std::size_t end = n; end > 0 && !result;)
+		{
+			const std::size_t begin = end > 64 ? end - 64 : 0;
+			uint64_t greater = 0, less = 0;
+			for(std::size_t i = begin; i < end; i += 8)
+			{
+				const unsigned lanes = end - i < 8 ? unsigned(end - i) : 8u;
+				const __mmask8 valid = static_cast<__mmask8>((1u << lanes) - 1);
+				__m512i x = _mm512_maskz_loadu_epi64(valid, a + i);
+				__m512i y = _mm512_maskz_loadu_epi64(valid, b + i);
+				if(is_signed && i + lanes == n)
+				{
+					/// the top word compares as unsigned with its sign bit flipped
+					const __mmask8 top = static_cast<__mmask8>(1u << (lanes - 1));
+					x = _mm512_mask_xor_epi64(x, top, x, flip);
+					y = _mm512_mask_xor_epi64(y, top, y, flip);
+				}
+				greater |= uint64_t(_mm512_cmpgt_epu64_mask(x, y)) << (i - begin);
+				less |= uint64_t(_mm512_cmplt_epu64_mask(x, y)) << (i - begin);
+			}
+			result = static_cast<int8_t>((greater > less) - (greater < less));
+			end = begin;
+		}
+		out[k] = result;
+	}
+}
+
+}
+
+namespace avx2 {
+
+/// As the AVX-512 variant with four words per register. AVX2 only compares signed, so both
+/// operands get their sign bits flipped, except the top word of signed values.
+__attribute__((target("avx2")))
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept
+{
+	const __m256i flip = _mm256_set1_epi64x(int64_t(uint64_t(1) << 63));
+	const uint64_t top_flip = is_signed ? 0 : uint64_t(1) << 63;
+	for(std::size_t k = 0; k < count; k++, a += n, b += n)
+	{
+		int8_t result = 0;
+		for(std::size_t end = n; end > 0 && !result;)
+		{
+			const std::size_t begin = end > 64 ? end - 64 : 0;
+			uint64_t greater = 0, less = 0;
+			std::size_t i = begin;
+			for(; i + 4 <= end && (!is_signed || i + 4 < n); i += 4)
+			{
+				const __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)), flip);
+				const __m256i y = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)), flip);
+				greater |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, y)))) << (i - begin);
+				less |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(y, x)))) << (i - begin);
+			}
+			for(; i < end; i++)
+			{
+				const uint64_t f = i + 1 == n ? top_flip : uint64_t(1) << 63;
+				const int64_t x = int64_t(a[i] ^ f);
+				const int64_t y = int64_t(b[i] ^ f);
+				greater |= uint64_t(x > y) << (i - begin);
+				less |= uint64_t(x < y) << (i - begin);
+			}
+			result = static_cast<int8_t>((greater > less) - (greater < less));
+			end = begin;
+		}
+		out[k] = result;
+	}
+}
+
+}
+
+namespace avx512ifma {
+
+namespace {
+
+constexpr std::size_t max_words = montgomery_max_words;
+constexpr std::size_t max_digits = (64 * max_words + 51) / 52;
+
+/// Digits of 52 bits, a * 2^52 + b keeps the sum of ~80 partial products in 64 bits
+__attribute__((target("avx512f")))
+inline __m512i digit_mask() noexcept
+{
+	return _mm512_set1_epi64((uint64_t(1) << 52) - 1);
+}
+
+/// Carry every digit into the next one, the last digit keeps its excess
+__attribute__((target("avx512f")))
+inline void normalize(__m512i * t, std::size_t count) noexcept
+{
+	for(std::size_t j = 0; j + 1 < count; j++)
+	{
+		t[j+1] = _mm512_add_epi64(t[j+1], _mm512_srli_epi64(t[j], 52));
+		t[j] = _mm512_and_si512(t[j], digit_mask());
+	}
+}
+
+/// Gather the words of up to eight values and split them into digits, one value per lane
+__attribute__((target("avx512f")))
+inline void to_digits(__m512i * d, const uint64_t * x, __m512i index, __mmask8 valid, std::size_t n, std::size_t digits) noexcept
+{
+	__m512i w[max_words + 1];
+	for(std::size_t q = 0; q < n; q++)
+	{
+		w[q] = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), valid, index, x + q, 8);
+	}
+	w[n] = _mm512_setzero_si512();
+	for(std::size_t j = 0; j < digits; j++)
+	{
+		const std::size_t q = 52 * j / 64;
+		const uint64_t s = 52 * j % 64;
+		const __m512i lo = _mm512_srlv_epi64(w[q], _mm512_set1_epi64(s));
+		const __m512i hi = _mm512_sllv_epi64(w[q+1], _mm512_set1_epi64(64 - s));
+		d[j] = _mm512_and_si512(_mm512_or_si512(lo, hi), digit_mask());
+	}
+}
+
+/// Join normalized digits to words and scatter them, counts of 64 and more shift in zeros
+__attribute__((target("avx512f")))
+inline void from_digits(uint64_t * x, const __m512i * d, __m512i index, __mmask8 valid, std::size_t n, std::size_t digits) noexcept
+{
+	for(std::size_t q = 0; q < n; q++)
+	{
+		const std::size_t j = 64 * q / 52;
+		const uint64_t s = 64 * q % 52;
+		__m512i w = _mm512_srlv_epi64(d[j], _mm512_set1_epi64(s));
+		if(j + 1 < digits)
+		{
+			w = _mm512_or_si512(w, _mm512_sllv_epi64(d[j+1], _mm512_set1_epi64(52 - s)));
+		}
+		if(j + 2 < digits)
+		{
+			w = _mm512_or_si512(w, _mm512_sllv_epi64(d[j+2], _mm512_set1_epi64(104 - s)));
+		}
+		_mm512_mask_i64scatter_epi64(x + q, valid, index, w, 8);
+	}
+}
+
+}
+
+/// Montgomery reduction by 2^52 per round while full digits remain, the last round of a
+/// product digit reduces the remaining 64 n mod 52 bits so that R = 2^(64 n) as in the
+/// word kernels
+__attribute__((target("avx512f,avx512ifma")))
+void montgomery_mul_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, const uint64_t * m, uint64_t m_inv, std::size_t n, std::size_t count) noexcept
+{
+	if(n > max_words)
+	{
+		std::abort();
+	}
+	const std::size_t digits = (64 * n + 51) / 52;
+	const std::size_t full = 64 * n / 52;
+	const unsigned rest = static_cast<unsigned>(64 * n - 52 * full);
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i inverse = _mm512_set1_epi64(m_inv & ((uint64_t(1) << 52) - 1));
+
+	__m512i md[max_digits + 1];
+	const __m512i broadcast = _mm512_setzero_si512();
+	to_digits(md, m, broadcast, 1, n, digits);
+	for(std::size_t j = 0; j < digits; j++)
+	{
+		md[j] = _mm512_broadcastq_epi64(_mm512_castsi512_si128(md[j]));
+	}
+	md[digits] = zero;
+
+	const uint64_t stride = n;
+	const __m512i index = _mm512_set_epi64(7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+	for(std::size_t k = 0; k < count; k += 8)
+	{
+		const std::size_t lanes = count - k < 8 ? count - k : 8;
+		const __mmask8 valid = static_cast<__mmask8>((1u << lanes) - 1);
+		__m512i ad[max_digits];
+		__m512i bd[max_digits];
+		__m512i t[max_digits + 2];
+		to_digits(ad, a + k * n, index, valid, n, digits);
+		to_digits(bd, b + k * n, index, valid, n, digits);
+		for(std::size_t j = 0; j < digits + 2; j++)
+		{
+			t[j] = zero;
+		}
+
+		for(std::size_t i = 0; i < digits; i++)
+		{
+			for(std::size_t j = 0; j < digits; j++)
+			{
+				t[j] = _mm512_madd52lo_epu64(t[j], ad[j], bd[i]);
+				t[j+1] = _mm512_madd52hi_epu64(t[j+1], ad[j], bd[i]);
+			}
+			if(i < full)
+			{
+				/// t + q * m = 0 mod 2^52, move the carry of the zero digit and shift one digit down
+				const __m512i q = _mm512_madd52lo_epu64(zero, t[0], inverse);
+				for(std::size_t j = 0; j < digits; j++)
+				{
+					t[j] = _mm512_madd52lo_epu64(t[j], q, md[j]);
+					t[j+1] = _mm512_madd52hi_epu64(t[j+1], q, md[j]);
+				}
+				t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+				for(std::size_t j = 0; j + 1 < digits + 2; j++)
+				{
+					t[j] = t[j+1];
+				}
+				t[digits+1] = zero;
+			}
+		}
+		normalize(t, digits + 1);
+		if(rest)
+		{
+			/// t + q * m = 0 mod 2^rest, then shift by rest bits
+			const __m512i q = _mm512_and_si512(_mm512_madd52lo_epu64(zero, t[0], inverse), _mm512_set1_epi64((uint64_t(1) << rest) - 1));
+			for(std::size_t j = 0; j < digits; j++)
+			{
+				t[j] = _mm512_madd52lo_epu64(t[j], q, md[j]);
+				t[j+1] = _mm512_madd52hi_epu64(t[j+1], q, md[j]);
+			}
+			normalize(t, digits + 1);
+			for(std::size_t j = 0; j < digits; j++)
+			{
+				t[j] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(t[j], rest), _mm512_slli_epi64(t[j+1], 52 - rest)), digit_mask());
+			}
+			t[digits] = _mm512_srli_epi64(t[digits], rest);
+		}
+
+		/// t < 2 m, subtract m where no borrow is left
+		__m512i d[max_digits + 1];
+		__m512i borrow = zero;
+		for(std::size_t j = 0; j <= digits; j++)
+		{
+			d[j] = _mm512_sub_epi64(_mm512_sub_epi64(t[j], md[j]), borrow);
+			borrow = _mm512_srli_epi64(d[j], 63);
+			d[j] = _mm512_and_si512(d[j], digit_mask());
+		}
+		const __mmask8 reduce = _mm512_cmpeq_epi64_mask(borrow, zero);
+		for(std::size_t j = 0; j < digits; j++)
+		{
+			d[j] = _mm512_mask_blend_epi64(reduce, t[j], d[j]);
+		}
+		from_digits(r + k * n, d, index, valid, n, digits);
+	}
+}
+
+}
+
+namespace pclmul {
+
+__attribute__((target("pclmul,sse4.1")))
+void clmul(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	std::fill(r, r + 2 * n, 0);
+	for(std::size_t i = 0; i < n; i++)
+	{
+		const __m128i x = _mm_cvtsi64_si128(static_cast<long long>(a[i]));
+		for(std::size_t j = 0; j < n; j++)
+		{
+			const __m128i p = _mm_clmulepi64_si128(x, _mm_cvtsi64_si128(static_cast<long long>(b[j])), 0x00);
+			r[i+j] ^= static_cast<uint64_t>(_mm_cvtsi128_si64(p));
+			r[i+j+1] ^= static_cast<uint64_t>(_mm_extract_epi64(p, 1));
+		}
+	}
+}
+
+}
+
+#endif
+
+#if defined(__x86_64__) && defined(__ELF__)
+
+/// ifunc resolvers run while the loader relocates the library, before any constructor, so
+/// they only use detect()
+
+using mul_add_function = void (*)(uint64_t *, const uint64_t *, const uint64_t *, std::size_t) noexcept;
+using add_function = uint64_t (*)(uint64_t *, const uint64_t *, const uint64_t *, std::size_t) noexcept;
+using batch_function = void (*)(uint64_t *, const uint64_t *, const uint64_t *, std::size_t, std::size_t) noexcept;
+using clmul_function = mul_add_function;
+using compare_function = void (*)(int8_t *, const uint64_t *, const uint64_t *, std::size_t, std::size_t, bool) noexcept;
+using montgomery_function = void (*)(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t, std::size_t, std::size_t) noexcept;
+
+extern "C" {
+
+static mul_add_function biginteger_resolve_mul_add() noexcept
+{
+	const cpu_features features = detect();
+	return features.bmi2 && features.adx ? adx::mul_add : generic::mul_add;
+}
+
+static add_function biginteger_resolve_add() noexcept
+{
+	const cpu_features features = detect();
+	return features.avx512f ? avx512::add : features.adx ? adx::add : generic::add;
+}
+
+static add_function biginteger_resolve_sub() noexcept
+{
+	const cpu_features features = detect();
+	return features.avx512f ? avx512::sub : features.adx ? adx::sub : generic::sub;
+}
+
+static batch_function biginteger_resolve_add_batch() noexcept
+{
+	return detect().avx512f ? avx512::add_batch : generic::add_batch;
+}
+
+static batch_function biginteger_resolve_sub_batch() noexcept
+{
+	return detect().avx512f ? avx512::sub_batch : generic::sub_batch;
+}
+
+static montgomery_function biginteger_resolve_montgomery_mul_batch() noexcept
+{
+	return detect().avx512ifma ? avx512ifma::montgomery_mul_batch : generic::montgomery_mul_batch;
+}
+
+static clmul_function biginteger_resolve_clmul() noexcept
+{
+	return detect().pclmulqdq ? pclmul::clmul : generic::clmul;
+}
+
+static compare_function biginteger_resolve_compare_batch() noexcept
+{
+	const cpu_features features = detect();
+	return features.avx512f ? avx512::compare_batch : features.avx2 ? avx2::compare_batch : generic::compare_batch;
+}
+
+}
+
+void mul_add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept __attribute__((ifunc("biginteger_resolve_mul_add")));
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept __attribute__((ifunc("biginteger_resolve_add")));
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept __attribute__((ifunc("biginteger_resolve_sub")));
+void add_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept __attribute__((ifunc("biginteger_resolve_add_batch")));
+void sub_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept __attribute__((ifunc("biginteger_resolve_sub_batch")));
+void montgomery_mul_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, const uint64_t * m, uint64_t m_inv, std::size_t n, std::size_t count) noexcept __attribute__((ifunc("biginteger_resolve_montgomery_mul_batch")));
+void clmul(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept __attribute__((ifunc("biginteger_resolve_clmul")));
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept __attribute__((ifunc("biginteger_resolve_compare_batch")));
+
+#else
+
+void mul_add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	generic::mul_add(r, a, b, n);
+}
+
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	return generic::add(r, a, b, n);
+}
+
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	return generic::sub(r, a, b, n);
+}
+
+void add_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept
+{
+	generic::add_batch(r, a, b, n, count);
+}
+
+void sub_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept
+{
+	generic::sub_batch(r, a, b, n, count);
+}
+
+void montgomery_mul_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, const uint64_t * m, uint64_t m_inv, std::size_t n, std::size_t count) noexcept
+{
+	generic::montgomery_mul_batch(r, a, b, m, m_inv, n, count);
+}
+
+void clmul(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept
+{
+	generic::clmul(r, a, b, n);
+}
+
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept
+{
+	generic::compare_batch(out, a, b, n, count, is_signed);
+}
+
+#endif
+
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// Word kernels of the BigInteger library with run time CPU dispatch.
+/// The kernels work on little endian arrays of n 64 bit words. The public entry points
+/// are bound once at program start (ifunc on x86-64 ELF targets) to the best variant for
+/// the CPU, the variants are declared as well for tests and benchmarks.
+namespace biginteger::kernels {
+
+/// CPU features from cpuid, the vector extensions also require OS support of their state
+struct cpu_features
+{
+	bool bmi2 = false;
+	bool adx = false;
+	bool avx2 = false;
+	bool avx512f = false;
+	bool avx512ifma = false;
+	bool pclmulqdq = false;
+	bool vpclmulqdq = false;
+};
+
+const cpu_features & cpu() noexcept;
+
+/// Smallest size in words for which BigInteger::mul_add calls the dispatched kernel, below
+/// it the inlined loop wins over the call
+inline constexpr std::size_t mul_add_words = 16;
+
+/// r += a * b, truncated to n words
+void mul_add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+
+/// r = a + b, returns the carry
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+
+/// r = a - b, returns the borrow
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+
+/// count independent sums or differences of n word values stored back to back
+void add_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept;
+void sub_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept;
+
+/// Largest size in words of montgomery_mul_batch, the kernels keep their scratch on the stack
+inline constexpr std::size_t montgomery_max_words = 64;
+
+/// count independent Montgomery products r = a * b * 2^(-64 n) mod m of n word values stored
+/// back to back, m odd, m_inv = -m^-1 mod 2^64, the operands below m and n at most
+/// montgomery_max_words
+void montgomery_mul_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, const uint64_t * m, uint64_t m_inv, std::size_t n, std::size_t count) noexcept;
+
+/// r = a * b as binary polynomials, r has 2 n words
+void clmul(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+
+/// out[k] = -1, 0 or 1 as count pairs of n word values stored back to back compare, with
+/// the top word signed for two's complement values
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept;
+
+/// Portable variants, always available
+namespace generic {
+void mul_add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+void add_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept;
+void sub_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept;
+void montgomery_mul_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, const uint64_t * m, uint64_t m_inv, std::size_t n, std::size_t count) noexcept;
+void clmul(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept;
+}
+
+#if defined(__x86_64__)
+/// mulx and adcx/adox, requires cpu().bmi2 && cpu().adx
+namespace adx {
+void mul_add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+}
+
+/// Eight words per register, the carries between the words are resolved with mask
+/// arithmetic. Requires cpu().avx512f
+namespace avx512 {
+uint64_t add(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+uint64_t sub(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+void add_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept;
+void sub_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count) noexcept;
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept;
+}
+
+/// Four word comparisons per instruction, requires cpu().avx2
+namespace avx2 {
+void compare_batch(int8_t * out, const uint64_t * a, const uint64_t * b, std::size_t n, std::size_t count, bool is_signed) noexcept;
+}
+
+/// One product per lane in radix 2^52 with vpmadd52luq/vpmadd52huq, eight products per
+/// instruction. Requires cpu().avx512ifma
+namespace avx512ifma {
+void montgomery_mul_batch(uint64_t * r, const uint64_t * a, const uint64_t * b, const uint64_t * m, uint64_t m_inv, std::size_t n, std::size_t count) noexcept;
+}
+
+/// One 64 x 64 bit product per instruction, requires cpu().pclmulqdq
+namespace pclmul {
+void clmul(uint64_t * r, const uint64_t * a, const uint64_t * b, std::size_t n) noexcept;
+}
+#endif
+
+}
+
+#endif // KERNELS_H
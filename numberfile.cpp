@@ -0,0 +1,88 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "numberfile.h"
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace biginteger::detail {
+
+TextFile::TextFile(const std::string & path)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0)
+	{
+		throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+	}
+	struct stat info;
+	if(::fstat(fd, &info) != 0)
+	{
+		const int error = errno;
+		::close(fd);
+		throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+	}
+	size = static_cast<std::size_t>(info.st_size);
+	/// an empty file can not be mapped and has no lines
+	void * mapping = size ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+	const int error = errno;
+	::close(fd);
+	if(mapping == MAP_FAILED)
+	{
+		throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+	}
+	if(mapping)
+	{
+		/// every chunk is read once from front to back
+		::madvise(mapping, size, MADV_SEQUENTIAL);
+	}
+	data = static_cast<const char *>(mapping);
+}
+
+TextFile::~TextFile()
+{
+	if(data)
+	{
+		::munmap(const_cast<char *>(data), size);
+	}
+}
+
+std::vector<std::string_view> split_lines(std::string_view text, std::size_t parts)
+{
+	std::vector<std::string_view> chunks;
+	const std::size_t target = (text.size() + parts - 1) / std::max<std::size_t>(parts, 1);
+	while(!text.empty())
+	{
+		std::size_t end = text.size();
+		if(target < text.size())
+		{
+			const std::size_t newline = text.find('\n', target - 1);
+			end = newline == text.npos ? text.size() : newline + 1;
+		}
+		chunks.push_back(text.substr(0, end));
+		text.remove_prefix(end);
+	}
+	return chunks;
+}
+
+}
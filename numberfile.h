@@ -0,0 +1,379 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NUMBERFILE_H
+#define NUMBERFILE_H
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "biginteger.h"
+
+/// Parallel parsing of text files with one number per line, or one number per line in a
+/// column of a CSV file. Numbers are decimal, or hex with a 0x prefix, with an optional
+/// minus sign for signed types. Spaces around a field are ignored and empty lines are
+/// skipped. The file is memory mapped and split into one chunk of whole lines per thread.
+namespace biginteger {
+
+struct NumberFileOptions
+{
+	/// Field separator and the 0 based column that holds the number
+	char separator = ',';
+	std::size_t column = 0;
+	unsigned threads = std::thread::hardware_concurrency();
+};
+
+template<big_integer T>
+struct NumberFile
+{
+	/// Values of the well formed lines in file order
+	std::vector<T> values;
+	/// 1 based numbers of the lines without a number of T, such as a CSV header
+	std::vector<std::size_t> malformed;
+};
+
+namespace detail {
+
+/// Read only mapping of a whole file, throws std::system_error if it cannot be mapped
+class TextFile
+{
+public:
+	explicit TextFile(const std::string & path);
+	TextFile(const TextFile &) = delete;
+	TextFile & operator=(const TextFile &) = delete;
+	~TextFile();
+
+	std::string_view text() const
+	{
+		return {data, size};
+	}
+
+private:
+	const char * data = nullptr;
+	std::size_t size = 0;
+};
+
+/// Split text into at most parts chunks that end after a line break or at the end
+std::vector<std::string_view> split_lines(std::string_view text, std::size_t parts);
+
+/// Value of the 8 decimal digits at p, false if one of them is not a digit. All digits are
+/// converted at once: pairs, then quadruples, then the whole word (SWAR).
+inline bool parse_eight_digits(const char * p, uint64_t & value)
+{
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	if constexpr(std::endian::native == std::endian::big)
+	{
+		v = __builtin_bswap64(v);
+	}
+	/// every byte is 0x30 to 0x39: high nibble 3, and adding 6 keeps it at 3
+	if(((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) != 0x3333333333333333)
+	{
+		return false;
+	}
+	v &= 0x0F0F0F0F0F0F0F0F;
+	v = (v * 10 + (v >> 8)) & 0x00FF00FF00FF00FF;
+	v = (v * 100 + (v >> 16)) & 0x0000FFFF0000FFFF;
+	value = (v * 10000 + (v >> 32)) & 0xFFFFFFFF;
+	return true;
+}
+
+/// Value of the 8 hex digits at p, false if one of them is not a hex digit
+inline bool parse_eight_hex_digits(const char * p, uint64_t & value)
+{
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	if constexpr(std::endian::native == std::endian::big)
+	{
+		v = __builtin_bswap64(v);
+	}
+	/// per byte range checks on ASCII, digits are 0x30 to 0x39 and letters 0x61 to 0x66 in lower case
+	constexpr uint64_t ones = 0x0101010101010101;
+	const uint64_t lower = v | 0x20 * ones;
+	const uint64_t digit = (v + 0x50 * ones) & ~(v + 0x46 * ones);
+	const uint64_t letter = (lower + 0x1F * ones) & ~(lower + 0x19 * ones);
+	if((v & 0x80 * ones) || ((digit | letter) & 0x80 * ones) != 0x80 * ones)
+	{
+		return false;
+	}
+	v = (lower & 0x0F * ones) + ((letter >> 7) & ones) * 9;
+	v = (v * 16 + (v >> 8)) & 0x00FF00FF00FF00FF;
+	v = (v * 256 + (v >> 16)) & 0x0000FFFF0000FFFF;
+	value = (v * 65536 + (v >> 32)) & 0xFFFFFFFF;
+	return true;
+}
+
+/// Multiply the words by m and add a, false on overflow
+template<std::size_t N>
+constexpr bool mul_add_small(std::array<uint64_t,N> & words, uint64_t m, uint64_t a)
+{
+	for(std::size_t i = 0; i < N; i++)
+	{
+		const __uint128_t t = __uint128_t(words[i]) * m + a;
+		words[i] = static_cast<uint64_t>(t);
+		a = static_cast<uint64_t>(t >> 64);
+	}
+	return a == 0;
+}
+
+/// Parse one field, false if it is not a number that fits into T
+template<big_integer T>
+constexpr bool parse_number(std::string_view field, T & value)
+{
+	constexpr bool is_signed = T(0u) > ~T(0u);
+	constexpr std::size_t N = T::word_count;
+	while(!field.empty() && (field.front() == ' ' || field.front() == '\t'))
+	{
+		field.remove_prefix(1);
+	}
+	while(!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r'))
+	{
+		field.remove_suffix(1);
+	}
+	bool negative = false;
+	if(is_signed && !field.empty() && field.front() == '-')
+	{
+		negative = true;
+		field.remove_prefix(1);
+	}
+	const bool hex = field.size() > 2 && field[0] == '0' && (field[1] == 'x' || field[1] == 'X');
+	if(hex)
+	{
+		field.remove_prefix(2);
+	}
+	if(field.empty())
+	{
+		return false;
+	}
+
+	std::array<uint64_t,N> words{};
+	if(hex)
+	{
+		while(field.size() > 1 && field.front() == '0')
+		{
+			field.remove_prefix(1);
+		}
+		if(field.size() > N * 16)
+		{
+			return false;
+		}
+		/// each word collects its 16 digits in a register, letters and digits are mixed at
+		/// random so the digit value is selected without a branch
+		bool invalid = false;
+		for(std::size_t k = 0; 16 * k < field.size(); k++)
+		{
+			const std::size_t end = field.size() - 16 * k;
+			uint64_t word = 0;
+			if(end >= 16 && !std::is_constant_evaluated())
+			{
+				uint64_t high, low;
+				if(!parse_eight_hex_digits(field.data() + end - 16, high) || !parse_eight_hex_digits(field.data() + end - 8, low))
+				{
+					return false;
+				}
+				word = high << 32 | low;
+			}
+			else
+			{
+				for(std::size_t i = end > 16 ? end - 16 : 0; i < end; i++)
+				{
+					const unsigned char c = field[i];
+					const unsigned decimal = c - '0';
+					const unsigned letter = (c | 0x20u) - 'a';
+					invalid |= (decimal > 9) & (letter > 5);
+					word = word << 4 | (decimal > 9 ? letter + 10 : decimal);
+				}
+			}
+			words[k] = word;
+		}
+		if(invalid)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		/// chunks of up to 16 digits, each one multiply and add over the words
+		std::size_t length = field.size() % 16 ? field.size() % 16 : 16;
+		for(std::size_t index = 0; index < field.size(); length = 16)
+		{
+			uint64_t chunk = 0;
+			uint64_t scale = 1;
+			if(length == 16 && !std::is_constant_evaluated())
+			{
+				uint64_t high, low;
+				if(!parse_eight_digits(field.data() + index, high) || !parse_eight_digits(field.data() + index + 8, low))
+				{
+					return false;
+				}
+				chunk = high * 100000000 + low;
+				scale = 10000000000000000;
+				index += 16;
+			}
+			else
+			{
+				for(const std::size_t end = index + length; index < end; index++)
+				{
+					const unsigned digit = static_cast<unsigned char>(field[index]) - '0';
+					if(digit > 9)
+					{
+						return false;
+					}
+					chunk = chunk * 10 + digit;
+					scale *= 10;
+				}
+			}
+			if(!mul_add_small(words, scale, chunk))
+			{
+				return false;
+			}
+		}
+	}
+
+	value = T::from_words(words);
+	if constexpr(is_signed)
+	{
+		/// the magnitude of a negative value may be one larger than the maximum
+		if(value < 0u && !(negative && value == (T(1u) << (T::bit_size - 1))))
+		{
+			return false;
+		}
+		if(negative)
+		{
+			value = -value;
+		}
+	}
+	return true;
+}
+
+/// Parse the lines of one chunk, malformed holds chunk local 0 based line numbers
+template<big_integer T>
+std::size_t parse_lines(std::string_view text, const NumberFileOptions & options, NumberFile<T> & result)
+{
+	std::size_t line = 0;
+	while(!text.empty())
+	{
+		const std::size_t end = std::min(text.find('\n'), text.size());
+		std::string_view field = text.substr(0, end);
+		text.remove_prefix(std::min(end + 1, text.size()));
+		if(field.find_first_not_of(" \t\r") == field.npos)
+		{
+			line++;
+			continue;
+		}
+		bool valid = true;
+		for(std::size_t column = 0; valid && column < options.column; column++)
+		{
+			const std::size_t separator = field.find(options.separator);
+			valid = separator != field.npos;
+			field.remove_prefix(valid ? separator + 1 : 0);
+		}
+		field = field.substr(0, field.find(options.separator));
+		T value;
+		if(valid && parse_number(field, value))
+		{
+			result.values.push_back(value);
+		}
+		else
+		{
+			result.malformed.push_back(line);
+		}
+		line++;
+	}
+	return line;
+}
+
+}
+
+/// Parse the numbers of a text, the chunks of whole lines are parsed in parallel
+template<big_integer T>
+NumberFile<T> parse_numbers(std::string_view text, const NumberFileOptions & options = {})
+{
+	/// chunks below this size are not worth a thread
+	constexpr std::size_t min_chunk = 1 << 20;
+	const std::size_t count = std::clamp<std::size_t>(text.size() / min_chunk, 1, std::max(options.threads, 1u));
+	const std::vector<std::string_view> chunks = detail::split_lines(text, count);
+	if(chunks.empty())
+	{
+		return {};
+	}
+	std::vector<NumberFile<T>> partial(chunks.size());
+	std::vector<std::size_t> lines(chunks.size());
+	auto parse = [&](std::size_t i) {
+		/// a value per line is the upper bound, except for a short last line
+		partial[i].values.reserve(std::count(chunks[i].begin(), chunks[i].end(), '\n') + 1);
+		lines[i] = detail::parse_lines(chunks[i], options, partial[i]);
+	};
+	std::vector<std::thread> workers;
+	for(std::size_t i = 1; i < chunks.size(); i++)
+	{
+		workers.emplace_back(parse, i);
+	}
+	parse(0);
+	for(std::thread & worker : workers)
+	{
+		worker.join();
+	}
+	if(partial.size() == 1)
+	{
+		for(std::size_t & line : partial[0].malformed)
+		{
+			line++;
+		}
+		return std::move(partial[0]);
+	}
+
+	/// concatenate in parallel, the malformed lines get the line offset of their chunk
+	NumberFile<T> result;
+	std::vector<std::size_t> offsets(partial.size() + 1);
+	std::size_t line = 1;
+	for(std::size_t i = 0; i < partial.size(); i++)
+	{
+		offsets[i + 1] = offsets[i] + partial[i].values.size();
+		for(const std::size_t malformed : partial[i].malformed)
+		{
+			result.malformed.push_back(line + malformed);
+		}
+		line += lines[i];
+	}
+	result.values.resize(offsets.back());
+	workers.clear();
+	for(std::size_t i = 1; i < partial.size(); i++)
+	{
+		workers.emplace_back([&, i] { std::copy(partial[i].values.begin(), partial[i].values.end(), result.values.begin() + offsets[i]); });
+	}
+	std::copy(partial[0].values.begin(), partial[0].values.end(), result.values.begin());
+	for(std::thread & worker : workers)
+	{
+		worker.join();
+	}
+	return result;
+}
+
+/// Map a text file and parse its numbers, throws std::system_error if it cannot be read
+template<big_integer T>
+NumberFile<T> read_numbers(const std::string & path, const NumberFileOptions & options = {})
+{
+	const detail::TextFile file(path);
+	return parse_numbers<T>(file.text(), options);
+}
+
+}
+
+#endif // NUMBERFILE_H
@@ -0,0 +1,737 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NUMBERTHEORY_H
+#define NUMBERTHEORY_H
+
+#include <random>
+
+#include "biginteger.h"
+
+namespace biginteger {
+
+/// Roots
+
+/// Integer square root floor(sqrt(n)) by Newton iteration.
+/// The seed 2^(bits(n)/2+1) lies above the root, so the iterates decrease
+/// monotonically and the first non-decreasing step marks the result.
+template<big_integer T>
+constexpr T isqrt(const T & n)
+{
+	if(n < T(0u))
+	{
+		detail::invalid_argument("Square root of negative number!");
+	}
+	else if(n < T(2u))
+	{
+		return n;
+	}
+	T x = T(1u) << (T::bits(n) / 2 + 1);
+	T y = (x + n / x) >> 1u;
+	while(y < x)
+	{
+		x = std::move(y);
+		y = (x + n / x) >> 1u;
+	}
+	return x;
+}
+
+/// Integer k-th root floor(n^(1/k)) by Newton iteration seeded with 2^(bits(n)/k+1).
+template<big_integer T, std::unsigned_integral K>
+constexpr T iroot(const T & n, K k)
+{
+	if(k == 0)
+	{
+		detail::invalid_argument("Zeroth root!");
+	}
+	else if(n < T(0u))
+	{
+		detail::invalid_argument("Root of negative number!");
+	}
+	else if(k == 1 || n < T(2u))
+	{
+		return n;
+	}
+	const auto msb_n = T::bits(n);
+	if(k > msb_n) // n < 2^k
+	{
+		return T(1u);
+	}
+	/// n / x^(k-1), x^(k-1) is only built while it does not exceed n
+	auto quotient = [&n, msb_n, k](const T & x) -> T {
+		constexpr auto digits = T::bit_size - (T(0u) > ~T(0u) ? 1 : 0);
+		const auto msb_x = T::bits(x);
+		T p = x;
+		for(K i = 2; i < k; i++)
+		{
+			const auto msb_p = T::bits(p);
+			if(msb_p + msb_x > msb_n || (msb_p + msb_x + 2 > digits && p > n / x))
+			{
+				return 0u;
+			}
+			p *= x;
+		}
+		return n / p;
+	};
+	const T k_1 = k - 1;
+	const T kk = k;
+	T x = T(1u) << (msb_n / k + 1);
+	T y = (k_1 * x + quotient(x)) / kk;
+	while(y < x)
+	{
+		x = std::move(y);
+		y = (k_1 * x + quotient(x)) / kk;
+	}
+	return x;
+}
+
+/// Check if n is a square number.
+template<big_integer T>
+constexpr bool is_perfect_square(const T & n)
+{
+	if(n < T(0u))
+	{
+		return false;
+	}
+	/// squares are 0, 1, 4 or 9 modulo 16
+	const auto low = n.extract(0, 4);
+	if(low != 0 && low != 1 && low != 4 && low != 9)
+	{
+		return false;
+	}
+	const T r = isqrt(n);
+	return r * r == n;
+}
+
+namespace detail {
+
+/// l = (l + r) mod m for l, r < m
+template<std::size_t N>
+constexpr void add_mod_words(std::array<uint64_t,N> & l, const std::array<uint64_t,N> & r, const std::array<uint64_t,N> & m)
+{
+	if(add_words(l, r) || compare_words(l, m) >= 0)
+	{
+		sub_words(l, m);
+	}
+}
+
+/// Remainder of a division by a single word
+template<std::size_t N>
+constexpr uint64_t mod_word(const std::array<uint64_t,N> & l, uint64_t r)
+{
+	__uint128_t rem = 0;
+	for(std::size_t i = N; i-- > 0;)
+	{
+		rem = ((rem << 64) | l[i]) % r;
+	}
+	return static_cast<uint64_t>(rem);
+}
+
+/// 64 bit random word from any engine, full range engines are used directly.
+template<std::uniform_random_bit_generator G>
+constexpr uint64_t random_word(G & g)
+{
+	if constexpr(G::min() == 0 && G::max() == std::numeric_limits<uint64_t>::max())
+	{
+		return g();
+	}
+	else
+	{
+		return std::uniform_int_distribution<uint64_t>{}(g);
+	}
+}
+
+inline constexpr std::array<uint8_t,54> small_primes = {
+	2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97,
+	101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199,
+	211, 223, 227, 229, 233, 239, 241, 251};
+
+}
+
+/// Montgomery arithmetic modulo an odd number m with R = 2^(64 * word_count).
+/// Values in Montgomery form are x * R mod m and are kept in [0, m).
+template<big_integer T>
+class Montgomery
+{
+	static constexpr std::size_t N = T::word_count;
+	using words = std::array<uint64_t,N>;
+
+public:
+	constexpr explicit Montgomery(const T & modulus)
+		: m(modulus.to_words())
+	{
+		if((m[0] & 1) == 0)
+		{
+			detail::invalid_argument("Montgomery modulus must be odd!");
+		}
+		/// Newton iteration for m^-1 mod 2^64, every step doubles the correct bits
+		uint64_t inv = m[0];
+		for(int i = 0; i < 5; i++)
+		{
+			inv *= 2 - m[0] * inv;
+		}
+		m_inv = -inv;
+		/// R mod m and R^2 mod m by modular doubling of 1
+		words r{modulus == T(1u) ? 0u : 1u};
+		for(std::size_t i = 0; i < 2 * 64 * N; i++)
+		{
+			const words temp = r;
+			detail::add_mod_words(r, temp, m);
+			if(i + 1 == 64 * N)
+			{
+				r1 = r;
+			}
+		}
+		r2 = r;
+	}
+
+	constexpr T modulus() const
+	{
+		return T::from_words(m);
+	}
+
+	/// Montgomery form of 1
+	constexpr T one() const
+	{
+		return T::from_words(r1);
+	}
+
+	/// x * R mod m for non negative x
+	constexpr T to_montgomery(const T & x) const
+	{
+		auto w = x.to_words();
+		if(detail::compare_words(w, m) >= 0)
+		{
+			w = (x % modulus()).to_words();
+		}
+		return T::from_words(mul(w, r2));
+	}
+
+	/// x * R^-1 mod m
+	constexpr T from_montgomery(const T & x) const
+	{
+		return T::from_words(mul(x.to_words(), words{1u}));
+	}
+
+	constexpr T mul(const T & l, const T & r) const
+	{
+		return T::from_words(mul(l.to_words(), r.to_words()));
+	}
+
+	/// out[k] = mul(l[k], r[k]) for operands in Montgomery form. At run time the batch kernel
+	/// computes eight products per instruction in radix 2^52 on CPUs with AVX-512 IFMA, up to
+	/// kernels::montgomery_max_words words.
+	constexpr void mul_many(std::span<const T> l, std::span<const T> r, std::span<T> out) const
+	{
+		if(l.size() != r.size() || l.size() != out.size())
+		{
+			detail::invalid_argument("Different sizes!");
+		}
+#ifndef BIGINTEGER_HEADER_ONLY
+		if(N <= kernels::montgomery_max_words && !std::is_constant_evaluated())
+		{
+			constexpr std::size_t chunk = 32;
+			std::array<uint64_t,chunk * N> a, b, result;
+			for(std::size_t k = 0; k < out.size(); k += chunk)
+			{
+				const std::size_t count = std::min(chunk, out.size() - k);
+				for(std::size_t i = 0; i < count; i++)
+				{
+					const words lw = l[k+i].to_words();
+					const words rw = r[k+i].to_words();
+					std::copy(lw.begin(), lw.end(), a.begin() + i * N);
+					std::copy(rw.begin(), rw.end(), b.begin() + i * N);
+				}
+				kernels::montgomery_mul_batch(result.data(), a.data(), b.data(), m.data(), m_inv, N, count);
+				for(std::size_t i = 0; i < count; i++)
+				{
+					words w;
+					std::copy(result.begin() + i * N, result.begin() + (i + 1) * N, w.begin());
+					out[k+i] = T::from_words(w);
+				}
+			}
+			return;
+		}
+#endif
+		for(std::size_t k = 0; k < out.size(); k++)
+		{
+			out[k] = mul(l[k], r[k]);
+		}
+	}
+
+	/// x^e in Montgomery form with a fixed 4 bit window
+	constexpr T pow(const T & x, const T & e) const
+	{
+		return T::from_words(pow(x.to_words(), e.to_words()));
+	}
+
+private:
+	/// Coarsely integrated operand scanning (CIOS) product l * r * R^-1 mod m
+	constexpr words mul(const words & l, const words & r) const
+	{
+		std::array<uint64_t,N+2> t{};
+		for(std::size_t i = 0; i < N; i++)
+		{
+			uint64_t carry = 0;
+			for(std::size_t j = 0; j < N; j++)
+			{
+				__uint128_t sum = __uint128_t(l[j]) * r[i] + t[j] + carry;
+				t[j] = static_cast<uint64_t>(sum);
+				carry = static_cast<uint64_t>(sum >> 64);
+			}
+			__uint128_t sum = __uint128_t(t[N]) + carry;
+			t[N] = static_cast<uint64_t>(sum);
+			t[N+1] = static_cast<uint64_t>(sum >> 64);
+
+			/// add q * m with t + q * m = 0 mod 2^64 and shift one word down
+			const uint64_t q = t[0] * m_inv;
+			sum = __uint128_t(q) * m[0] + t[0];
+			carry = static_cast<uint64_t>(sum >> 64);
+			for(std::size_t j = 1; j < N; j++)
+			{
+				sum = __uint128_t(q) * m[j] + t[j] + carry;
+				t[j-1] = static_cast<uint64_t>(sum);
+				carry = static_cast<uint64_t>(sum >> 64);
+			}
+			sum = __uint128_t(t[N]) + carry;
+			t[N-1] = static_cast<uint64_t>(sum);
+			t[N] = t[N+1] + static_cast<uint64_t>(sum >> 64);
+		}
+		words result;
+		std::copy(t.begin(), t.begin() + N, result.begin());
+		if(t[N] || detail::compare_words(result, m) >= 0)
+		{
+			detail::sub_words(result, m);
+		}
+		return result;
+	}
+
+	constexpr words pow(const words & x, const words & e) const
+	{
+		std::array<words,16> table;
+		table[0] = r1;
+		for(std::size_t i = 1; i < table.size(); i++)
+		{
+			table[i] = mul(table[i-1], x);
+		}
+		auto digit = [&e](std::size_t i) { return (e[i / 16] >> ((i % 16) * 4)) & 15; };
+		std::size_t i = N * 16;
+		while(i > 0 && digit(i - 1) == 0)
+		{
+			i--;
+		}
+		if(i == 0)
+		{
+			return r1;
+		}
+		words result = table[digit(--i)];
+		while(i-- > 0)
+		{
+			for(int j = 0; j < 4; j++)
+			{
+				result = mul(result, result);
+			}
+			if(auto d = digit(i))
+			{
+				result = mul(result, table[d]);
+			}
+		}
+		return result;
+	}
+
+	words m;
+	uint64_t m_inv = 0;
+	words r1{};
+	words r2{};
+};
+
+/// Modular exponentiation b^e mod m for non negative numbers.
+/// Odd moduli use Montgomery products, even moduli fall back to binary
+/// double and add products.
+template<big_integer T>
+constexpr T powmod(const T & b, const T & e, const T & m)
+{
+	if(m == T(0u))
+	{
+		detail::invalid_argument("Modulo zero!");
+	}
+	else if(m.test(0))
+	{
+		Montgomery<T> mont(m);
+		return mont.from_montgomery(mont.pow(mont.to_montgomery(b), e));
+	}
+	const auto mm = m.to_words();
+	const auto bb = (b % m).to_words();
+	const auto ee = e.to_words();
+	auto mul = [&mm](const auto & l, const auto & r) {
+		std::array<uint64_t,T::word_count> result{};
+		for(std::size_t i = T::bit_size; i-- > 0;)
+		{
+			const auto temp = result;
+			detail::add_mod_words(result, temp, mm);
+			if((r[i / 64] >> (i % 64)) & 1)
+			{
+				detail::add_mod_words(result, l, mm);
+			}
+		}
+		return result;
+	};
+	auto result = (T(1u) % m).to_words();
+	for(std::size_t i = T::bits(e) + 1; i-- > 0;)
+	{
+		result = mul(result, result);
+		if((ee[i / 64] >> (i % 64)) & 1)
+		{
+			result = mul(result, bb);
+		}
+	}
+	return T::from_words(result);
+}
+
+/// Product of bases[k]^exponents[k] mod m for odd m with Straus' method: one table of 16
+/// powers per base and shared squarings, 4 per exponent digit for all bases together.
+template<big_integer T>
+constexpr T multi_powmod(std::span<const T> bases, std::span<const T> exponents, const T & m)
+{
+	if(bases.size() != exponents.size())
+	{
+		detail::invalid_argument("Different sizes!");
+	}
+	const Montgomery<T> mont(m);
+	std::vector<std::array<T,16>> tables(bases.size());
+	std::size_t digits = 0;
+	for(std::size_t k = 0; k < bases.size(); k++)
+	{
+		tables[k][0] = mont.one();
+		const T b = mont.to_montgomery(bases[k]);
+		for(std::size_t d = 1; d < 16; d++)
+		{
+			tables[k][d] = mont.mul(tables[k][d-1], b);
+		}
+		digits = std::max(digits, (bit_width(exponents[k]) + 3) / 4);
+	}
+	T result = mont.one();
+	for(std::size_t i = digits; i-- > 0;)
+	{
+		for(int j = 0; j < 4; j++)
+		{
+			result = mont.mul(result, result);
+		}
+		for(std::size_t k = 0; k < bases.size(); k++)
+		{
+			const auto d = (exponents[k].to_words()[i / 16] >> ((i % 16) * 4)) & 15;
+			if(d)
+			{
+				result = mont.mul(result, tables[k][d]);
+			}
+		}
+	}
+	return mont.from_montgomery(result);
+}
+
+/// g^e mod m for a fixed base g and odd modulus m.
+/// The table holds g^(d 2^(w i)) for every window i of w bits of the exponent and every
+/// digit d, so an exponentiation is one product per non zero digit and no squarings.
+/// The table has ceil(exponent_bits / w) * (2^w - 1) entries. It is built once and can be
+/// stored with serialize() and loaded back with the span constructor.
+template<big_integer T>
+class FixedBasePow
+{
+	static constexpr std::size_t N = T::word_count;
+
+public:
+	constexpr FixedBasePow(const T & base, const T & modulus, std::size_t exponent_bits = T::bit_size, std::size_t window = 4)
+		: mont(modulus), exponent_bits(exponent_bits), window(window)
+	{
+		check_shape();
+		const std::size_t columns = (std::size_t(1) << window) - 1;
+		table.reserve(rows() * columns);
+		T g = mont.to_montgomery(base);
+		for(std::size_t i = 0; i < rows(); i++)
+		{
+			T x = g;
+			for(std::size_t d = 1; d <= columns; d++)
+			{
+				table.push_back(x);
+				x = mont.mul(x, g);
+			}
+			/// g^(2^(w (i + 1)))
+			g = x;
+		}
+	}
+
+	/// Load a table written by serialize()
+	constexpr explicit FixedBasePow(std::span<const uint64_t> serialized)
+		: mont(read_modulus(serialized)), exponent_bits(serialized[1]), window(serialized[2])
+	{
+		check_shape();
+		const std::size_t entries = rows() * ((std::size_t(1) << window) - 1);
+		if(serialized.size() != 3 + N + entries * N)
+		{
+			detail::invalid_argument("Serialized table has the wrong size!");
+		}
+		table.reserve(entries);
+		for(std::size_t k = 0; k < entries; k++)
+		{
+			std::array<uint64_t,N> w;
+			std::copy_n(serialized.begin() + 3 + N + k * N, N, w.begin());
+			table.push_back(T::from_words(w));
+		}
+	}
+
+	constexpr T modulus() const
+	{
+		return mont.modulus();
+	}
+
+	/// g^e mod m, exponents wider than exponent_bits fall back to square and multiply
+	constexpr T pow(const T & e) const
+	{
+		return mont.from_montgomery(pow_montgomery(mont.one(), e));
+	}
+
+	/// g^e h^f mod m, both tables feed the same product so the cost is the sum of the digits
+	constexpr T pow(const T & e, const FixedBasePow & h, const T & f) const
+	{
+		if(h.modulus() != modulus())
+		{
+			detail::invalid_argument("Different moduli!");
+		}
+		return mont.from_montgomery(h.pow_montgomery(pow_montgomery(mont.one(), e), f));
+	}
+
+	/// Words of T::word_count, exponent_bits, window, modulus and the table in Montgomery form
+	std::vector<uint64_t> serialize() const
+	{
+		std::vector<uint64_t> data = {N, exponent_bits, window};
+		const auto m = modulus().to_words();
+		data.insert(data.end(), m.begin(), m.end());
+		for(const T & x : table)
+		{
+			const auto w = x.to_words();
+			data.insert(data.end(), w.begin(), w.end());
+		}
+		return data;
+	}
+
+private:
+	constexpr std::size_t rows() const
+	{
+		return (exponent_bits + window - 1) / window;
+	}
+
+	constexpr void check_shape() const
+	{
+		if(window == 0 || window > 16 || exponent_bits == 0 || exponent_bits > T::bit_size)
+		{
+			detail::invalid_argument("Invalid table shape!");
+		}
+	}
+
+	static constexpr T read_modulus(std::span<const uint64_t> serialized)
+	{
+		if(serialized.size() < 3 + N || serialized[0] != N)
+		{
+			detail::invalid_argument("Serialized table has the wrong size!");
+		}
+		std::array<uint64_t,N> m;
+		std::copy_n(serialized.begin() + 3, N, m.begin());
+		return T::from_words(m);
+	}
+
+	/// acc * g^e in Montgomery form
+	constexpr T pow_montgomery(T acc, const T & e) const
+	{
+		if(bit_width(e) > exponent_bits)
+		{
+			return mont.mul(acc, mont.pow(table[0], e));
+		}
+		const auto ew = e.to_words();
+		const std::size_t columns = (std::size_t(1) << window) - 1;
+		for(std::size_t i = 0; i < rows(); i++)
+		{
+			/// window bits starting at bit i w, they may cross a word boundary
+			const std::size_t bit = i * window;
+			uint64_t d = ew[bit / 64] >> (bit % 64);
+			if(bit % 64 + window > 64 && bit / 64 + 1 < N)
+			{
+				d |= ew[bit / 64 + 1] << (64 - bit % 64);
+			}
+			d &= columns;
+			if(d)
+			{
+				acc = mont.mul(acc, table[i * columns + d - 1]);
+			}
+		}
+		return acc;
+	}
+
+	Montgomery<T> mont;
+	std::size_t exponent_bits;
+	std::size_t window;
+	std::vector<T> table;
+};
+
+/// Random numbers
+
+/// Uniform random number over all bit patterns, the words are taken directly from the engine.
+template<big_integer T, std::uniform_random_bit_generator G>
+constexpr T random(G & g)
+{
+	std::array<uint64_t,T::word_count> words;
+	for(auto & w : words)
+	{
+		w = detail::random_word(g);
+	}
+	return T::from_words(words);
+}
+
+/// Uniform random number in [0, bound) by rejection sampling of bits(bound) + 1 bits.
+template<big_integer T, std::uniform_random_bit_generator G>
+constexpr T random_below(G & g, const T & bound)
+{
+	if(bound <= T(0u))
+	{
+		detail::invalid_argument("Empty range!");
+	}
+	const auto b = bound.to_words();
+	const std::size_t top = T::bits(bound) / 64;
+	const uint64_t mask = ~uint64_t(0) >> (63 - T::bits(bound) % 64);
+	std::array<uint64_t,T::word_count> words{};
+	do
+	{
+		for(std::size_t i = 0; i <= top; i++)
+		{
+			words[i] = detail::random_word(g);
+		}
+		words[top] &= mask;
+	}
+	while(detail::compare_words(words, b) >= 0);
+	return T::from_words(words);
+}
+
+/// Primality
+
+namespace detail {
+
+/// Trial division by the small primes, one long division per product of primes fitting into a word.
+/// Returns 0 for no small factor, otherwise the factor.
+template<std::size_t N>
+constexpr uint64_t small_factor(const std::array<uint64_t,N> & n)
+{
+	std::size_t i = 0;
+	while(i < small_primes.size())
+	{
+		uint64_t product = 1;
+		std::size_t j = i;
+		while(j < small_primes.size() && product <= std::numeric_limits<uint64_t>::max() / small_primes[j])
+		{
+			product *= small_primes[j++];
+		}
+		const uint64_t rem = mod_word(n, product);
+		for(; i < j; i++)
+		{
+			if(rem % small_primes[i] == 0)
+			{
+				return small_primes[i];
+			}
+		}
+	}
+	return 0;
+}
+
+/// Miller-Rabin round for n - 1 = d * 2^s, true if n is a strong probable prime to base.
+template<big_integer T>
+constexpr bool miller_rabin(const Montgomery<T> & mont, const T & d, std::size_t s, const T & base)
+{
+	const T one = mont.one();
+	const T minus_one = mont.modulus() - one;
+	T x = mont.pow(mont.to_montgomery(base), d);
+	if(x == one || x == minus_one)
+	{
+		return true;
+	}
+	for(std::size_t i = 1; i < s; i++)
+	{
+		x = mont.mul(x, x);
+		if(x == minus_one)
+		{
+			return true;
+		}
+		else if(x == one)
+		{
+			return false;
+		}
+	}
+	return false;
+}
+
+/// Trial division and decomposition n - 1 = d * 2^s, calls round(mont, d, s) unless decided.
+template<big_integer T, typename F>
+constexpr bool probable_prime(const T & n, F && round)
+{
+	if(n < T(2u))
+	{
+		return false;
+	}
+	else if(auto p = small_factor(n.to_words()))
+	{
+		return n == T(p);
+	}
+	T d = n - 1u;
+	const std::size_t s = countr_zero(d);
+	d >>= s;
+	return round(Montgomery<T>(n), d, s);
+}
+
+}
+
+/// Miller-Rabin test with the first rounds primes as bases (at most 54).
+template<big_integer T>
+constexpr bool is_probable_prime(const T & n, unsigned rounds = 25)
+{
+	return detail::probable_prime(n, [rounds](const Montgomery<T> & mont, const T & d, std::size_t s) {
+		for(std::size_t i = 0; i < rounds && i < detail::small_primes.size(); i++)
+		{
+			if(!detail::miller_rabin(mont, d, s, T(detail::small_primes[i])))
+			{
+				return false;
+			}
+		}
+		return true;
+	});
+}
+
+/// Miller-Rabin test with random bases in [2, n - 2].
+template<big_integer T, std::uniform_random_bit_generator G>
+constexpr bool is_probable_prime(const T & n, unsigned rounds, G & g)
+{
+	return detail::probable_prime(n, [rounds, &n, &g](const Montgomery<T> & mont, const T & d, std::size_t s) {
+		for(unsigned i = 0; i < rounds; i++)
+		{
+			if(!detail::miller_rabin(mont, d, s, random_below(g, n - 3u) + 2u))
+			{
+				return false;
+			}
+		}
+		return true;
+	});
+}
+
+}
+
+#endif // NUMBERTHEORY_H
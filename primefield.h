@@ -0,0 +1,355 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIMEFIELD_H
+#define PRIMEFIELD_H
+
+#include "biginteger.h"
+#include "numbertheory.h"
+
+namespace biginteger {
+
+/// Integers modulo a prime of special form m = 2^k - c with c small against 2^k, like
+/// 2^255 - 19, 2^256 - 2^32 - 977 or 2^448 - 2^224 - 1. Modulus is a type with a static constexpr member value
+/// of an unsigned BigInteger type, the modulus is fixed at compile time.
+/// The bits of a product above 2^k are folded back with 2^k = c mod m, a shift and a
+/// multiply by the words of c, a single word for pseudo Mersenne primes. Every fold
+/// removes k - bit_width(c) bits. Values are kept
+/// fully reduced in [0, m).
+template<typename Modulus>
+class PrimeField
+{
+public:
+	using value_type = std::remove_cv_t<decltype(Modulus::value)>;
+
+private:
+	using T = value_type;
+	static constexpr std::size_t N = T::word_count;
+	using words = std::array<uint64_t,N>;
+	using wide_words = std::array<uint64_t,2 * N>;
+
+	static_assert(T(0u) < ~T(0u) && Modulus::value > T(2u), "The modulus must be an odd prime of an unsigned type");
+
+	static constexpr std::size_t k = bit_width(Modulus::value);
+	static constexpr T c = (k == T::bit_size ? T(0u) : T(1u) << k) - Modulus::value;
+	static constexpr std::size_t c_words = (bit_width(c) + 63) / 64;
+
+	static_assert(c > T(0u) && bit_width(c) < k, "The modulus must have the form 2^k - c with c below 2^(k-1)");
+
+	static constexpr words m = Modulus::value.to_words();
+	static constexpr words c_array = c.to_words();
+
+public:
+	constexpr PrimeField() = default;
+
+	/// x mod m
+	constexpr explicit PrimeField(const T & x)
+	{
+		wide_words wide{};
+		const words w = x.to_words();
+		std::copy(w.begin(), w.end(), wide.begin());
+		v = reduce_folds(wide);
+	}
+
+	static constexpr T modulus()
+	{
+		return Modulus::value;
+	}
+
+	/// Representative in [0, m)
+	constexpr T value() const
+	{
+		return T::from_words(v);
+	}
+
+	friend constexpr PrimeField operator+(const PrimeField & l, const PrimeField & r)
+	{
+		PrimeField sum = l;
+		detail::add_mod_words(sum.v, r.v, m);
+		return sum;
+	}
+
+	friend constexpr PrimeField & operator+=(PrimeField & l, const PrimeField & r)
+	{
+		return l = l + r;
+	}
+
+	friend constexpr PrimeField operator-(const PrimeField & l, const PrimeField & r)
+	{
+		PrimeField diff = l;
+		if(detail::sub_words(diff.v, r.v))
+		{
+			detail::add_words(diff.v, m);
+		}
+		return diff;
+	}
+
+	friend constexpr PrimeField & operator-=(PrimeField & l, const PrimeField & r)
+	{
+		return l = l - r;
+	}
+
+	friend constexpr PrimeField operator-(const PrimeField & x)
+	{
+		return PrimeField() - x;
+	}
+
+	friend constexpr PrimeField operator*(const PrimeField & l, const PrimeField & r)
+	{
+		wide_words product{};
+		for(std::size_t i = 0; i < N; i++)
+		{
+			uint64_t carry = 0;
+			for(std::size_t j = 0; j < N; j++)
+			{
+				const __uint128_t t = __uint128_t(l.v[i]) * r.v[j] + product[i+j] + carry;
+				product[i+j] = static_cast<uint64_t>(t);
+				carry = static_cast<uint64_t>(t >> 64);
+			}
+			product[i+N] = carry;
+		}
+		return from_reduced(reduce(product));
+	}
+
+	friend constexpr PrimeField & operator*=(PrimeField & l, const PrimeField & r)
+	{
+		return l = l * r;
+	}
+
+	/// x^2, the cross products are computed once and doubled
+	constexpr PrimeField sqr() const
+	{
+		wide_words square{};
+		for(std::size_t i = 0; i < N; i++)
+		{
+			uint64_t carry = 0;
+			for(std::size_t j = i + 1; j < N; j++)
+			{
+				const __uint128_t t = __uint128_t(v[i]) * v[j] + square[i+j] + carry;
+				square[i+j] = static_cast<uint64_t>(t);
+				carry = static_cast<uint64_t>(t >> 64);
+			}
+			square[i+N] = carry;
+		}
+		uint64_t top = 0;
+		for(auto & w : square)
+		{
+			const uint64_t next = w >> 63;
+			w = (w << 1) | top;
+			top = next;
+		}
+		uint64_t carry = 0;
+		for(std::size_t i = 0; i < N; i++)
+		{
+			const __uint128_t d = __uint128_t(v[i]) * v[i];
+			__uint128_t t = __uint128_t(square[2*i]) + static_cast<uint64_t>(d) + carry;
+			square[2*i] = static_cast<uint64_t>(t);
+			t = __uint128_t(square[2*i+1]) + static_cast<uint64_t>(d >> 64) + static_cast<uint64_t>(t >> 64);
+			square[2*i+1] = static_cast<uint64_t>(t);
+			carry = static_cast<uint64_t>(t >> 64);
+		}
+		return from_reduced(reduce(square));
+	}
+
+	/// x^e with a fixed 4 bit window
+	constexpr PrimeField pow(const T & e) const
+	{
+		std::array<PrimeField,16> table;
+		table[0] = PrimeField(T(1u));
+		for(std::size_t i = 1; i < table.size(); i++)
+		{
+			table[i] = table[i-1] * *this;
+		}
+		const auto ew = e.to_words();
+		auto digit = [&ew](std::size_t i) { return (ew[i / 16] >> ((i % 16) * 4)) & 15; };
+		PrimeField result = table[0];
+		for(std::size_t i = N * 16; i-- > 0;)
+		{
+			for(int j = 0; j < 4; j++)
+			{
+				result = result.sqr();
+			}
+			result *= table[digit(i)];
+		}
+		return result;
+	}
+
+	/// x^-1 = x^(m-2), throws for zero
+	constexpr PrimeField inv() const
+	{
+		if(*this == PrimeField())
+		{
+			detail::invalid_argument("Inverse of zero!");
+		}
+		return pow(Modulus::value - 2u);
+	}
+
+	friend constexpr PrimeField operator/(const PrimeField & l, const PrimeField & r)
+	{
+		return l * r.inv();
+	}
+
+	friend constexpr PrimeField & operator/=(PrimeField & l, const PrimeField & r)
+	{
+		return l = l / r;
+	}
+
+	friend constexpr bool operator==(const PrimeField & l, const PrimeField & r) = default;
+
+private:
+	static constexpr PrimeField from_reduced(const words & w)
+	{
+		PrimeField x;
+		x.v = w;
+		return x;
+	}
+
+	/// Product or square x < m^2 mod m
+	static constexpr words reduce(const wide_words & x)
+	{
+		if constexpr(c_words == 1 && 2 * bit_width(c) + 3 < k)
+		{
+			return reduce_two_folds(x);
+		}
+		else
+		{
+			return reduce_folds(x);
+		}
+	}
+
+	/// x mod m for any x: fold x = hi * 2^k + lo to lo + hi * c until hi is zero, then
+	/// x < 2^k = m + c and one subtraction is left
+	static constexpr words reduce_folds(wide_words x)
+	{
+		constexpr std::size_t q = k / 64;
+		constexpr std::size_t s = k % 64;
+		while(true)
+		{
+			wide_words hi{};
+			bool any = false;
+			for(std::size_t i = 0; i + q < 2 * N; i++)
+			{
+				uint64_t w = x[i+q] >> s;
+				if constexpr(s != 0)
+				{
+					w |= i + q + 1 < 2 * N ? x[i+q+1] << (64 - s) : 0;
+				}
+				hi[i] = w;
+				any |= w != 0;
+			}
+			if(!any)
+			{
+				break;
+			}
+			for(std::size_t i = q + (s != 0); i < 2 * N; i++)
+			{
+				x[i] = 0;
+			}
+			if constexpr(s != 0)
+			{
+				x[q] &= (uint64_t(1) << s) - 1;
+			}
+			/// x < 2^k + hi * c < 2^(2 k) fits
+			for(std::size_t i = 0; i + q < 2 * N; i++)
+			{
+				uint64_t carry = 0;
+				for(std::size_t j = 0; j < c_words && i + j < 2 * N; j++)
+				{
+					const __uint128_t t = __uint128_t(hi[i]) * c_array[j] + x[i+j] + carry;
+					x[i+j] = static_cast<uint64_t>(t);
+					carry = static_cast<uint64_t>(t >> 64);
+				}
+				for(std::size_t j = i + c_words; carry && j < 2 * N; j++)
+				{
+					x[j] += carry;
+					carry = x[j] < carry;
+				}
+			}
+		}
+		words result;
+		std::copy(x.begin(), x.begin() + N, result.begin());
+		if(detail::compare_words(result, m) >= 0)
+		{
+			detail::sub_words(result, m);
+		}
+		return result;
+	}
+
+	/// Single word c and x < 2^(2 k): the first fold leaves N + 1 words, the second a value
+	/// below 2 m
+	static constexpr words reduce_two_folds(const wide_words & x)
+	{
+		constexpr std::size_t q = k / 64;
+		constexpr std::size_t s = k % 64;
+		constexpr uint64_t cw = c_array[0];
+		auto high = [](const auto & w, std::size_t i) {
+			uint64_t h = i + q < w.size() ? w[i+q] >> s : 0;
+			if constexpr(s != 0)
+			{
+				h |= i + q + 1 < w.size() ? w[i+q+1] << (64 - s) : 0;
+			}
+			return h;
+		};
+		auto mask_low = [](auto & w) {
+			for(std::size_t i = q + (s != 0); i < w.size(); i++)
+			{
+				w[i] = 0;
+			}
+			if constexpr(s != 0)
+			{
+				w[q] &= (uint64_t(1) << s) - 1;
+			}
+		};
+
+		std::array<uint64_t,N+1> y{};
+		std::copy(x.begin(), x.begin() + N, y.begin());
+		mask_low(y);
+		uint64_t carry = 0;
+		for(std::size_t i = 0; i <= N; i++)
+		{
+			const __uint128_t t = __uint128_t(high(x, i)) * cw + y[i] + carry;
+			y[i] = static_cast<uint64_t>(t);
+			carry = static_cast<uint64_t>(t >> 64);
+		}
+
+		const uint64_t top = high(y, 0);
+		mask_low(y);
+		carry = 0;
+		__uint128_t t = __uint128_t(top) * cw + y[0];
+		y[0] = static_cast<uint64_t>(t);
+		carry = static_cast<uint64_t>(t >> 64);
+		for(std::size_t i = 1; i <= N; i++)
+		{
+			y[i] += carry;
+			carry = y[i] < carry;
+		}
+
+		words result;
+		std::copy(y.begin(), y.begin() + N, result.begin());
+		if(y[N] || detail::compare_words(result, m) >= 0)
+		{
+			detail::sub_words(result, m);
+		}
+		return result;
+	}
+
+	words v{};
+};
+
+}
+
+#endif // PRIMEFIELD_H
@@ -0,0 +1,287 @@
+/*
+ * This file is part of the BigInteger distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RNSINTEGER_H
+#define RNSINTEGER_H
+
+#include "biginteger.h"
+
+namespace biginteger {
+
+namespace detail {
+
+/// Montgomery reduction t * 2^-64 mod p for t < p * 2^64, m_inv = -p^-1 mod 2^64
+constexpr uint64_t redc64(__uint128_t t, uint64_t p, uint64_t m_inv)
+{
+	const uint64_t m = static_cast<uint64_t>(t) * m_inv;
+	const uint64_t u = static_cast<uint64_t>((t + __uint128_t(m) * p) >> 64);
+	return u >= p ? u - p : u;
+}
+
+constexpr uint64_t powmod64(uint64_t b, uint64_t e, uint64_t m)
+{
+	__uint128_t result = 1, base = b % m;
+	for(; e; e >>= 1)
+	{
+		if(e & 1)
+		{
+			result = result * base % m;
+		}
+		base = base * base % m;
+	}
+	return static_cast<uint64_t>(result);
+}
+
+/// Deterministic Miller-Rabin for 64 bit numbers
+constexpr bool is_prime64(uint64_t n)
+{
+	if(n < 2)
+	{
+		return false;
+	}
+	for(uint64_t p : {2u, 3u, 5u, 7u, 11u, 13u, 17u, 19u, 23u, 29u, 31u, 37u})
+	{
+		if(n % p == 0)
+		{
+			return n == p;
+		}
+	}
+	uint64_t d = n - 1;
+	const int s = std::countr_zero(d);
+	d >>= s;
+	for(uint64_t a : {2u, 3u, 5u, 7u, 11u, 13u, 17u, 19u, 23u, 29u, 31u, 37u})
+	{
+		__uint128_t x = powmod64(a, d, n);
+		if(x == 1 || x == n - 1)
+		{
+			continue;
+		}
+		int i = 1;
+		for(; i < s && x != n - 1; i++)
+		{
+			x = x * x % n;
+		}
+		if(x != n - 1)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+}
+
+/// Residue number system representation of T.
+/// The value is kept modulo K primes below 2^62 with product M, so additions and
+/// products run independently per residue without carries between them.
+/// Represented are the integers in [-(M-1)/2, (M-1)/2], the default K covers
+/// 2 * bit_size + 1 bits, so the product of two values converts back exactly.
+/// Conversion into a BigInteger type wraps like the arithmetic of that type.
+template<big_integer T, std::size_t K = (2 * T::bit_size + 61) / 61>
+class RnsInteger
+{
+	static constexpr std::size_t N = T::word_count;
+
+	/// Per prime constants, precomputed at compile time
+	struct Constants
+	{
+		std::array<uint64_t,K> p{};
+		/// -p^-1 mod 2^64
+		std::array<uint64_t,K> m_inv{};
+		/// 2^(64 i) * R^2 mod p, converts word i into Montgomery form
+		std::array<std::array<uint64_t,N>,K> word{};
+		/// p_j^-1 mod p_i in Montgomery form for the mixed radix conversion, j < i
+		std::array<std::array<uint64_t,K>,K> inv{};
+	};
+
+	static consteval Constants make_constants()
+	{
+		Constants c;
+		uint64_t candidate = (uint64_t(1) << 62) - 1;
+		for(std::size_t i = 0; i < K; i++)
+		{
+			while(!detail::is_prime64(candidate))
+			{
+				candidate -= 2;
+			}
+			const uint64_t p = c.p[i] = candidate;
+			candidate -= 2;
+
+			uint64_t inv = p;
+			for(int j = 0; j < 5; j++)
+			{
+				inv *= 2 - p * inv;
+			}
+			c.m_inv[i] = -inv;
+
+			/// R mod p, then 2^(64 i) * R^2 = (R mod p)^(i + 2)
+			const uint64_t r = static_cast<uint64_t>((__uint128_t(1) << 64) % p);
+			__uint128_t w = __uint128_t(r) * r % p;
+			for(std::size_t j = 0; j < N; j++)
+			{
+				c.word[i][j] = static_cast<uint64_t>(w);
+				w = w * r % p;
+			}
+			for(std::size_t j = 0; j < i; j++)
+			{
+				/// Montgomery form of p_j^-1 is p_j^(p-2) * R
+				c.inv[i][j] = static_cast<uint64_t>(__uint128_t(detail::powmod64(c.p[j], p - 2, p)) * r % p);
+			}
+		}
+		return c;
+	}
+
+	static constexpr Constants constants = make_constants();
+
+public:
+	static constexpr std::array<uint64_t,K> moduli = constants.p;
+
+	constexpr RnsInteger() = default;
+
+	constexpr explicit RnsInteger(const T & n)
+	{
+		const bool negative = n < T(0u);
+		const auto words = negative ? (-n).to_words() : n.to_words();
+		for(std::size_t i = 0; i < K; i++)
+		{
+			const uint64_t p = constants.p[i];
+			uint64_t r = 0;
+			for(std::size_t j = 0; j < N; j++)
+			{
+				r += detail::redc64(__uint128_t(words[j]) * constants.word[i][j], p, constants.m_inv[i]);
+				r = r >= p ? r - p : r;
+			}
+			residues[i] = negative && r ? p - r : r;
+		}
+	}
+
+	/// Value modulo 2^U::bit_size by mixed radix (Garner) conversion.
+	template<big_integer U = T>
+	constexpr U to_integer() const
+	{
+		/// mixed radix digits v with value = v0 + v1 p0 + v2 p0 p1 + ...
+		std::array<uint64_t,K> v;
+		for(std::size_t i = 0; i < K; i++)
+		{
+			const uint64_t p = constants.p[i];
+			/// leave Montgomery form
+			uint64_t t = detail::redc64(residues[i], p, constants.m_inv[i]);
+			for(std::size_t j = 0; j < i; j++)
+			{
+				/// all primes are in [2^61, 2^62), so v_j < 2 p
+				const uint64_t vj = v[j] >= p ? v[j] - p : v[j];
+				t = t >= vj ? t - vj : t + p - vj;
+				t = detail::redc64(__uint128_t(t) * constants.inv[i][j], p, constants.m_inv[i]);
+			}
+			v[i] = t;
+		}
+		/// Horner scheme result = result * p_i + v_i on words
+		std::array<uint64_t,U::word_count> result{}, m{1u};
+		auto mul_add = [](auto & words, uint64_t f, uint64_t carry) {
+			for(auto & w : words)
+			{
+				const __uint128_t t = __uint128_t(w) * f + carry;
+				w = static_cast<uint64_t>(t);
+				carry = static_cast<uint64_t>(t >> 64);
+			}
+		};
+		for(std::size_t i = K; i-- > 0;)
+		{
+			mul_add(result, i + 1 < K ? constants.p[i] : 0u, v[i]);
+		}
+		/// (M-1)/2 has the mixed radix digits (p_i-1)/2, larger values are negative
+		std::size_t i = K;
+		while(i-- > 0 && v[i] == constants.p[i] / 2);
+		if(i < K && v[i] > constants.p[i] / 2)
+		{
+			for(auto p : constants.p)
+			{
+				mul_add(m, p, 0u);
+			}
+			detail::sub_words(result, m);
+		}
+		return U::from_words(result);
+	}
+
+	/// Residue modulo moduli[i]
+	constexpr uint64_t residue(std::size_t i) const
+	{
+		return detail::redc64(residues[i], constants.p[i], constants.m_inv[i]);
+	}
+
+	friend constexpr RnsInteger operator+(const RnsInteger & l, const RnsInteger & r)
+	{
+		RnsInteger sum;
+		for(std::size_t i = 0; i < K; i++)
+		{
+			const uint64_t s = l.residues[i] + r.residues[i];
+			sum.residues[i] = s >= constants.p[i] ? s - constants.p[i] : s;
+		}
+		return sum;
+	}
+
+	friend constexpr RnsInteger & operator+=(RnsInteger & l, const RnsInteger & r)
+	{
+		return l = l + r;
+	}
+
+	friend constexpr RnsInteger operator-(const RnsInteger & l, const RnsInteger & r)
+	{
+		RnsInteger diff;
+		for(std::size_t i = 0; i < K; i++)
+		{
+			const uint64_t d = l.residues[i] - r.residues[i];
+			diff.residues[i] = l.residues[i] < r.residues[i] ? d + constants.p[i] : d;
+		}
+		return diff;
+	}
+
+	friend constexpr RnsInteger & operator-=(RnsInteger & l, const RnsInteger & r)
+	{
+		return l = l - r;
+	}
+
+	friend constexpr RnsInteger operator-(const RnsInteger & n)
+	{
+		return RnsInteger() - n;
+	}
+
+	friend constexpr RnsInteger operator*(const RnsInteger & l, const RnsInteger & r)
+	{
+		RnsInteger product;
+		for(std::size_t i = 0; i < K; i++)
+		{
+			product.residues[i] = detail::redc64(__uint128_t(l.residues[i]) * r.residues[i], constants.p[i], constants.m_inv[i]);
+		}
+		return product;
+	}
+
+	friend constexpr RnsInteger & operator*=(RnsInteger & l, const RnsInteger & r)
+	{
+		return l = l * r;
+	}
+
+	friend constexpr bool operator==(const RnsInteger & l, const RnsInteger & r) = default;
+
+private:
+	/// residues in Montgomery form x * 2^64 mod p
+	alignas(64) std::array<uint64_t,K> residues{};
+};
+
+}
+
+#endif // RNSINTEGER_H
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <vector>
+
+#include "testbiginteger.h"
+#include "accumulator.h"
+
+static constexpr bool proof_const = true;
+
+/// Sign extended conversion into the result type
+template<typename T>
+constexpr typename Accumulator<T>::result_type extend(const T & n)
+{
+	using W = typename Accumulator<T>::result_type;
+	std::array<uint64_t,W::word_count> words{};
+	const auto w = n.to_words();
+	std::copy(w.begin(), w.end(), words.begin());
+	if(n < T(0u))
+	{
+		std::fill(words.begin() + w.size(), words.end(), ~uint64_t(0));
+	}
+	return W::from_words(words);
+}
+
+TYPED_TEST(BigIntegerTests, Accumulator)
+{
+	using W = typename Accumulator<TypeParam>::result_type;
+	static_assert(W::bit_size > TypeParam::bit_size, "No overflow block");
+
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(Accumulator<TypeParam>().add(TypeParam(40u)).add(TypeParam(2u)).result() == W(42u), "Accumulator failed");
+	}
+
+	EXPECT_EQ(Accumulator<TypeParam>().result(), 0u);
+
+	/// overflowing sums of maximal values
+	Accumulator<TypeParam> acc;
+	W expected;
+	for(unsigned i = 0; i < 1000; i++)
+	{
+		acc.add(TypeParam::max());
+		expected += extend(TypeParam::max());
+	}
+	EXPECT_EQ(acc.result(), expected);
+	EXPECT_EQ(acc.result(), extend(TypeParam::max()) * 1000u);
+
+	std::mt19937_64 engine(6);
+	std::vector<TypeParam> values;
+	W sum;
+	for(unsigned i = 0; i < 5000; i++)
+	{
+		values.push_back(random<TypeParam>(engine));
+		sum += extend(values.back());
+	}
+	EXPECT_EQ(Accumulator<TypeParam>().add(values).result(), sum);
+
+	/// partial sums merged
+	Accumulator<TypeParam> low, high;
+	low.add(std::span(values).first(1234));
+	high.add(std::span(values).subspan(1234));
+	EXPECT_EQ(low.merge(high).result(), sum);
+
+	EXPECT_EQ(Accumulator<TypeParam>::sum(values, 4), sum);
+	EXPECT_EQ(Accumulator<TypeParam>::sum({}, 4), 0u);
+}
+
+TYPED_TEST(BigIntegerTests, AccumulatorThreads)
+{
+	using W = typename Accumulator<TypeParam>::result_type;
+	std::vector<TypeParam> values;
+	for(unsigned i = 0; i < 300000; i++)
+	{
+		values.push_back(TypeParam::max() - i);
+	}
+	/// n * max - n * (n - 1) / 2
+	const W n = 300000u;
+	const W expected = extend(TypeParam::max()) * n - n * (n - 1u) / 2u;
+	EXPECT_EQ(Accumulator<TypeParam>::sum(values, 1), expected);
+	EXPECT_EQ(Accumulator<TypeParam>::sum(values, 3), expected);
+	EXPECT_EQ(Accumulator<TypeParam>::sum(values, 64), expected);
+}
@@ -141,3 +141,11 @@ TYPED_TEST(BigIntegerTests, Add)
 	EXPECT_EQ(b2+a2, c2);
 	EXPECT_EQ(a2+b2, c2);
 }
+
+TYPED_TEST(BigIntegerTests, AddCarryChain)
+{
+	/// carry has to ripple through every block
+	TypeParam a = (TypeParam(1u) << (TypeParam::bit_size - 8)) - 1u;
+	EXPECT_EQ(a + 1u, TypeParam(1u) << (TypeParam::bit_size - 8));
+	EXPECT_EQ(TypeParam(1u) + a, TypeParam(1u) << (TypeParam::bit_size - 8));
+}
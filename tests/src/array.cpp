@@ -0,0 +1,122 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <vector>
+
+#include "testbiginteger.h"
+
+template<typename T>
+std::vector<T> random_values(std::size_t n, std::mt19937_64 & engine)
+{
+	std::vector<T> values;
+	for(std::size_t i = 0; i < n; i++)
+	{
+		switch(i % 4)
+		{
+		case 0: values.push_back(random<T>(engine)); break;
+		/// shared high bytes, differences only in the low blocks
+		case 1: values.push_back((T::max() >> 8u) - T(engine() % 1000u)); break;
+		case 2: values.push_back(T(engine() % 300u)); break;
+		default: values.push_back(-T(engine() % 300u)); break;
+		}
+	}
+	return values;
+}
+
+TYPED_TEST(BigIntegerTests, Compare)
+{
+	const TypeParam a = TypeParam(1u) << (TypeParam::bit_size - 2);
+	EXPECT_LT(TypeParam(1u), a);
+	EXPECT_GT(a, TypeParam(0xffffffffu));
+	EXPECT_LT(TypeParam(0xfffffffeu), TypeParam(0xffffffffu));
+	EXPECT_EQ(a <=> a, std::strong_ordering::equal);
+	if constexpr(std::is_signed_v<TypeParam>)
+	{
+		EXPECT_LT(-a, TypeParam(1u));
+		EXPECT_LT(TypeParam::min(), -a);
+	}
+	else
+	{
+		EXPECT_GT(-a, TypeParam(1u));
+	}
+}
+
+TYPED_TEST(BigIntegerTests, Sort)
+{
+	std::mt19937_64 engine(3);
+	for(std::size_t n : {0u, 1u, 2u, 63u, 64u, 1000u, 20000u})
+	{
+		auto values = random_values<TypeParam>(n, engine);
+		std::vector<TypeParam> expected;
+		for(const auto & v : values)
+		{
+			expected.push_back(v);
+		}
+		std::sort(expected.begin(), expected.end());
+		sort(std::span(values));
+		EXPECT_TRUE(values == expected) << n;
+	}
+}
+
+TYPED_TEST(BigIntegerTests, CompareMany)
+{
+	std::mt19937_64 engine(4);
+	const auto l = random_values<TypeParam>(1000, engine);
+	auto r = random_values<TypeParam>(1000, engine);
+	/// every other pair differs in one word only, so the lower words decide
+	for(std::size_t i = 0; i < r.size(); i += 2)
+	{
+		r[i] = l[i] ^ (TypeParam(engine() | 1u) << (64 * (engine() % TypeParam::word_count)));
+	}
+	r[5] = TypeParam(l[5]);
+	std::vector<int8_t> out(l.size());
+	compare_many(std::span(l), std::span(r), std::span(out));
+	for(std::size_t i = 0; i < l.size(); i++)
+	{
+		EXPECT_EQ(out[i], l[i] < r[i] ? -1 : l[i] > r[i] ? 1 : 0) << i;
+	}
+	EXPECT_EQ(out[5], 0);
+	EXPECT_THROW(compare_many(std::span(l), std::span(r).subspan(1), std::span(out)), std::invalid_argument);
+}
+
+TYPED_TEST(BigIntegerTests, MinMaxLowerBound)
+{
+	std::mt19937_64 engine(5);
+	auto values = random_values<TypeParam>(1000, engine);
+	const TypeParam low = min(std::span(values));
+	const TypeParam high = max(std::span(values));
+	for(const auto & v : values)
+	{
+		EXPECT_LE(low, v);
+		EXPECT_GE(high, v);
+	}
+	EXPECT_THROW(min(std::span<TypeParam>()), std::invalid_argument);
+
+	sort(std::span(values));
+	EXPECT_EQ(low, values.front());
+	EXPECT_EQ(high, values.back());
+	const std::span<const TypeParam> sorted(values);
+	for(std::size_t i = 0; i < values.size(); i += 7)
+	{
+		EXPECT_EQ(*lower_bound(sorted, values[i]), values[i]);
+		EXPECT_EQ(lower_bound(sorted, values[i]), std::lower_bound(sorted.begin(), sorted.end(), values[i]));
+		EXPECT_EQ(lower_bound(sorted, values[i] + 1u), std::lower_bound(sorted.begin(), sorted.end(), values[i] + 1u));
+	}
+	EXPECT_EQ(lower_bound(sorted, high), std::lower_bound(sorted.begin(), sorted.end(), high));
+	EXPECT_EQ(lower_bound(sorted, low), sorted.begin());
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+TYPED_TEST(BigIntegerTests, BitCount)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(popcount(TypeParam(0xf0f0u)) == 8, "Popcount failed");
+		static_assert(countr_zero(TypeParam(0xf0f0u)) == 4, "Count trailing zeros failed");
+		static_assert(countl_zero(TypeParam(0xf0f0u)) == TypeParam::bit_size - 16, "Count leading zeros failed");
+		static_assert(bit_width(TypeParam(0xf0f0u)) == 16, "Bit width failed");
+	}
+
+	EXPECT_EQ(popcount(TypeParam(0u)), 0u);
+	EXPECT_EQ(popcount(~TypeParam(0u)), TypeParam::bit_size);
+	EXPECT_EQ(popcount(TypeParam::max() - 1u), TypeParam::bit_size - 1 - std::is_signed_v<TypeParam>);
+	EXPECT_EQ(countr_zero(TypeParam(0u)), TypeParam::bit_size);
+	EXPECT_EQ(countl_zero(TypeParam(0u)), TypeParam::bit_size);
+	EXPECT_EQ(bit_width(TypeParam(0u)), 0u);
+	EXPECT_EQ(bit_width(TypeParam(1u)), 1u);
+	EXPECT_EQ(countl_zero(~TypeParam(0u)), 0u);
+	EXPECT_EQ(countr_zero(~TypeParam(0u)), 0u);
+
+	for(std::size_t i = 0; i < TypeParam::bit_size; i++)
+	{
+		TypeParam a = (TypeParam(1u) << i) | (TypeParam(1u) << (TypeParam::bit_size - 1));
+		EXPECT_EQ(countr_zero(a), i);
+		EXPECT_EQ(countl_zero(TypeParam(1u) << i), TypeParam::bit_size - 1 - i);
+		EXPECT_EQ(bit_width(TypeParam(1u) << i), i + 1);
+		EXPECT_EQ(TypeParam::bits(TypeParam(1u) << i), i);
+		EXPECT_EQ(popcount(a), i + 1 < TypeParam::bit_size ? 2u : 1u);
+	}
+}
+
+TYPED_TEST(BigIntegerTests, BitAccess)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(TypeParam(0u).set(TypeParam::bit_size - 1) == TypeParam::min() || TypeParam::min() == 0u, "Set bit failed");
+		static_assert(TypeParam(5u).test(2), "Test bit failed");
+		static_assert(TypeParam(0xabcdu).extract(4, 8) == 0xbc, "Extract failed");
+	}
+
+	TypeParam a;
+	for(std::size_t i = 0; i < TypeParam::bit_size; i += 3)
+	{
+		a.set(i);
+	}
+	for(std::size_t i = 0; i < TypeParam::bit_size; i++)
+	{
+		EXPECT_EQ(a.test(i), i % 3 == 0);
+		TypeParam b = (TypeParam(1u) << i);
+		EXPECT_EQ(TypeParam(0u).set(i), b);
+		EXPECT_EQ(TypeParam(0u).set(i).set(i, false), 0u);
+		EXPECT_EQ(TypeParam(~TypeParam(0u)).reset(i), ~b);
+		EXPECT_EQ(TypeParam(a).flip(i).flip(i), a);
+		EXPECT_EQ(TypeParam(a).flip(i).test(i), i % 3 != 0);
+	}
+
+	/// extract across block borders
+	TypeParam c;
+	for(std::size_t i = 0; i < TypeParam::word_count; i++)
+	{
+		c |= TypeParam(0x0123456789abcdefu) << (i * 64);
+	}
+	EXPECT_EQ(c.extract(0), 0x0123456789abcdefu);
+	EXPECT_EQ(c.extract(60), 0x123456789abcdef0u);
+	EXPECT_EQ(c.extract(60, 8), 0xf0u);
+	EXPECT_EQ(c.extract(TypeParam::bit_size - 8), 0x01u);
+	EXPECT_EQ(c.extract(TypeParam::bit_size, 8), 0u);
+	EXPECT_EQ(c.template extract<uint8_t>(60), 0xf0u);
+	EXPECT_EQ(c.template extract<__uint128_t>(0), (__uint128_t(0x0123456789abcdefu) << 64) | 0x0123456789abcdefu);
+	EXPECT_EQ(c.template extract<__uint128_t>(4, 100), ((__uint128_t(0x0123456789abcdefu) << 60) | 0x0123456789abcdeu) & ((__uint128_t(1) << 100) - 1));
+	/// windows wider than the result type cross the block borders of 128 bit limbs
+	EXPECT_EQ(c.extract(64, 128), 0x0123456789abcdefu);
+	EXPECT_EQ(c.extract(36, 200), 0x789abcdef0123456u);
+	EXPECT_EQ(c.template extract<uint8_t>(60, 64), 0xf0u);
+	EXPECT_EQ(c.extract(124, 128), TypeParam::bit_size > 128 ? 0x123456789abcdef0u : 0u);
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+template<typename T>
+static bool test_bit(const T & n, std::size_t i)
+{
+	return ((n >> i) & T(1u)) != T(0u);
+}
+
+/// Shift and xor, one bit of b at a time
+template<typename T>
+static double_width_t<T> clmul_reference(const T & a, const T & b)
+{
+	using W = double_width_t<T>;
+	W result(0u);
+	const W wide_a = W::from_words([&a] {
+		std::array<uint64_t,W::word_count> words{};
+		const auto low = a.to_words();
+		std::copy(low.begin(), low.end(), words.begin());
+		return words;
+	}());
+	for(std::size_t i = 0; i < T::bit_size; i++)
+	{
+		if(test_bit(b, i))
+		{
+			result ^= wide_a << i;
+		}
+	}
+	return result;
+}
+
+TYPED_TEST(BigIntegerTests, Clmul)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(clmul(TypeParam(3u), TypeParam(3u)) == 5u, "Carry-less multiply failed");
+		static_assert(clmul(TypeParam(0xffu), TypeParam(0x101u)) == 0xffffu, "Carry-less multiply failed");
+		static_assert(gf2_mul(TypeParam(1u) << (TypeParam::bit_size - 1), TypeParam(2u), TypeParam(0x87u)) == 0x87u, "GF(2^n) multiply failed");
+	}
+
+	std::mt19937_64 engine(2020);
+	for(int i = 0; i < 20; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		const TypeParam b = random<TypeParam>(engine);
+		const auto wide = clmul_wide(a, b);
+		EXPECT_EQ(wide, clmul_reference(a, b));
+		EXPECT_EQ(clmul(a, b).to_words()[0], wide.to_words()[0]);
+		EXPECT_EQ(clmul(a, b), clmul(b, a));
+		/// distributive over xor
+		const TypeParam c = random<TypeParam>(engine);
+		EXPECT_EQ(clmul_wide(a, b ^ c), wide ^ clmul_wide(a, c));
+	}
+	EXPECT_EQ(clmul(~TypeParam(0u), TypeParam(1u)), ~TypeParam(0u));
+}
+
+TYPED_TEST(BigIntegerTests, GF2Reduce)
+{
+	std::mt19937_64 engine(2020);
+	/// X^n + X^7 + X^2 + X + 1 for the GCM field, a wide polynomial folds more than twice
+	for(const TypeParam & poly : {TypeParam(0x87u), ~TypeParam(0u) >> 1u})
+	{
+		for(int i = 0; i < 10; i++)
+		{
+			const TypeParam a = random<TypeParam>(engine);
+			const TypeParam b = random<TypeParam>(engine);
+			const TypeParam c = random<TypeParam>(engine);
+			/// bit by bit reduction of the high half
+			auto product = clmul_reference(a, b);
+			for(std::size_t k = 2 * TypeParam::bit_size; k-- > TypeParam::bit_size;)
+			{
+				if(test_bit(product, k))
+				{
+					product ^= double_width_t<TypeParam>(1u) << k;
+					product ^= clmul_wide(poly, TypeParam(1u) << (k - TypeParam::bit_size));
+				}
+			}
+			const TypeParam expected = TypeParam::from_words([&product] {
+				std::array<uint64_t,TypeParam::word_count> words;
+				const auto all = product.to_words();
+				std::copy(all.begin(), all.begin() + TypeParam::word_count, words.begin());
+				return words;
+			}());
+			EXPECT_EQ(gf2_mul(a, b, poly), expected);
+			EXPECT_EQ(gf2_mul(a, b ^ c, poly), gf2_mul(a, b, poly) ^ gf2_mul(a, c, poly));
+			EXPECT_EQ(gf2_mul(gf2_mul(a, b, poly), c, poly), gf2_mul(a, gf2_mul(b, c, poly), poly));
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+#include "testbiginteger.h"
+#include "columnfile.h"
+
+TEST(ColumnFile, RoundTrip)
+{
+	const std::string path = (std::filesystem::temp_directory_path() / "biginteger_columns.bin").string();
+	std::mt19937_64 engine(2020);
+	std::vector<uint256_t> keys;
+	std::vector<int512_t> values;
+	std::vector<uint128_t> flags;
+	for(std::size_t i = 0; i < 1000; i++)
+	{
+		keys.push_back(random<uint256_t>(engine));
+		values.push_back(random<int512_t>(engine));
+		flags.push_back(uint128_t(i));
+	}
+
+	ColumnFileWriter writer;
+	writer.add(std::span<const uint256_t>(keys));
+	writer.add(std::span<const int512_t>(values));
+	writer.add(std::span<const uint128_t>(flags), false);
+	std::vector<uint256_t> shorter(999);
+	EXPECT_THROW(writer.add(std::span<const uint256_t>(shorter)), std::invalid_argument);
+	writer.write(path);
+
+	ColumnFile file(path);
+	ASSERT_EQ(file.rows(), 1000u);
+	ASSERT_EQ(file.columns(), 3u);
+	EXPECT_EQ(file.bits(1), 512u);
+
+	const auto k = file.column<uint256_t>(0);
+	EXPECT_TRUE(std::equal(k.begin(), k.end(), keys.begin(), keys.end()));
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(k.data()) % 64, 0u);
+	const auto v = file.column<int512_t>(1);
+	EXPECT_TRUE(std::equal(v.begin(), v.end(), values.begin(), values.end()));
+	const auto f = file.column<uint128_t>(2);
+	EXPECT_TRUE(std::equal(f.begin(), f.end(), flags.begin(), flags.end()));
+
+	const auto range = file.min_max<int512_t>(1);
+	ASSERT_TRUE(range.has_value());
+	EXPECT_EQ(range->first, *std::min_element(values.begin(), values.end()));
+	EXPECT_EQ(range->second, *std::max_element(values.begin(), values.end()));
+	EXPECT_FALSE(file.min_max<uint128_t>(2).has_value());
+
+	EXPECT_THROW(file.column<uint512_t>(1), std::invalid_argument);
+	EXPECT_THROW(file.column<uint256_t>(3), std::invalid_argument);
+
+	/// the mapping moves with the object
+	ColumnFile moved(std::move(file));
+	EXPECT_EQ(moved.column<uint256_t>(0)[17], keys[17]);
+
+	std::remove(path.c_str());
+}
+
+TEST(ColumnFile, Invalid)
+{
+	const std::string path = (std::filesystem::temp_directory_path() / "biginteger_not_columns.bin").string();
+	EXPECT_THROW(ColumnFile(path + ".missing"), std::system_error);
+	{
+		std::ofstream out(path, std::ios::binary);
+		out << "BIGICOLS but too short for the directory and not version 1";
+	}
+	EXPECT_THROW(ColumnFile{path}, std::invalid_argument);
+
+	/// truncated data
+	std::vector<uint256_t> keys(100, uint256_t(7u));
+	ColumnFileWriter writer;
+	writer.add(std::span<const uint256_t>(keys), false);
+	writer.write(path);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 32);
+	EXPECT_THROW(ColumnFile{path}, std::invalid_argument);
+	std::remove(path.c_str());
+}
@@ -15,6 +15,9 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "testbiginteger.h"
 
 TYPED_TEST(BigIntegerTests, StandardConstructor)
@@ -80,3 +83,43 @@ TYPED_TEST(BigIntegerTests, LiteralConstructor)
 	}
 }
 
+
+TYPED_TEST(BigIntegerTests, CopyAssign)
+{
+	static_assert(std::is_trivially_copyable_v<TypeParam>, "BigInteger must be trivially copyable");
+	static_assert([]{
+		TypeParam a(5u), b(7u);
+		a = b;
+		return a == 7u;
+	}(), "Copy assignment failed");
+
+	std::vector<TypeParam> values;
+	for(unsigned i = 0; i < 100; i++)
+	{
+		values.push_back(TypeParam(100u - i));
+	}
+	std::vector<TypeParam> copy(values.size());
+	std::copy(values.begin(), values.end(), copy.begin());
+	EXPECT_EQ(copy, values);
+	std::sort(copy.begin(), copy.end());
+	EXPECT_EQ(copy.front(), 1u);
+	EXPECT_EQ(copy.back(), 100u);
+	copy = values;
+	EXPECT_EQ(copy[0], 100u);
+}
+
+TEST(BigIntegerLiterals, Chunks)
+{
+	using namespace uint256;
+	/// decimal chunk borders at 19 digits
+	static_assert(1234567890123456789_num == uint256_t(1234567890123456789u), "Literal failed");
+	static_assert(12345678901234567890_num == uint256_t(1234567890123456789u) * 10u, "Literal failed");
+	static_assert(123456789012345678901234567890123456789_num ==
+				  uint256_t(1234567890123456789u) * (uint256_t(10000000000000000000u) * 10u) + 1234567890123456789u, "Literal failed");
+	/// hex and octal digits across block borders
+	static_assert(0x123456789abcdef0123456789ABCDEF0_num == (uint256_t(0x123456789abcdef0u) << 64u | 0x123456789abcdef0u), "Literal failed");
+	static_assert(0x1_num << 200u == 0x100000000000000000000000000000000000000000000000000_num, "Literal failed");
+	static_assert(01777777777777777777777_num == uint256_t(~uint64_t(0)), "Literal failed");
+	static_assert(02000000000000000000000_num == uint256_t(1u) << 64u, "Literal failed");
+	static_assert(0_num == 0u && 00_num == 0u && 0x0_num == 0u, "Literal failed");
+}
@@ -15,6 +15,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <random>
+
 #include "testbiginteger.h"
 
 static constexpr bool proof_const = false;
@@ -124,3 +126,38 @@ TYPED_TEST(BigIntegerTests, Divide)
 	EXPECT_THROW(a0/b0,std::invalid_argument);
 	EXPECT_EQ(a1/b1, c1);
 }
+
+TYPED_TEST(BigIntegerTests, DivmodInPlace)
+{
+	TypeParam q, rem;
+	EXPECT_EQ(divmod(TypeParam(17u), TypeParam(0u), q, rem), std::errc::invalid_argument);
+	EXPECT_EQ(divmod(TypeParam(17u), TypeParam(5u), q, rem), std::errc());
+	EXPECT_EQ(q, 3u);
+	EXPECT_EQ(rem, 2u);
+	EXPECT_EQ(divmod(TypeParam(17u), TypeParam(8u), q, rem), std::errc());
+	EXPECT_EQ(q, 2u);
+	EXPECT_EQ(rem, 1u);
+
+	std::mt19937_64 engine(39);
+	for(int i = 0; i < 50; i++)
+	{
+		const TypeParam l = random<TypeParam>(engine);
+		const TypeParam r = random<TypeParam>(engine) >> (engine() % TypeParam::bit_size);
+		if(r == 0u)
+		{
+			continue;
+		}
+		EXPECT_EQ(divmod(l, r, q, rem), std::errc());
+		EXPECT_EQ(q, l / r);
+		EXPECT_EQ(rem, l % r);
+		/// outputs aliasing the inputs
+		TypeParam a = TypeParam(l), b = TypeParam(r);
+		EXPECT_EQ(divmod(a, b, a, b), std::errc());
+		EXPECT_EQ(a, q);
+		EXPECT_EQ(b, rem);
+		a = TypeParam(l), b = TypeParam(r);
+		EXPECT_EQ(divmod(a, b, b, a), std::errc());
+		EXPECT_EQ(b, q);
+		EXPECT_EQ(a, rem);
+	}
+}
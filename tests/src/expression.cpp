@@ -0,0 +1,109 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+
+#include "testbiginteger.h"
+#include "expression.h"
+
+static constexpr bool proof_const = true;
+
+TYPED_TEST(BigIntegerTests, ExpressionFused)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert([]{ TypeParam a(3u), b(5u), c(7u); return evaluate(lazy(a) * b + c); }() == 22u, "mul add failed");
+		static_assert([]{ TypeParam a(3u), b(5u), c(7u); return evaluate(lazy(a) + b - c); }() == 1u, "add sub failed");
+		static_assert([]{ TypeParam a(3u), b(5u); return evaluate((lazy(a) << 4u) | b); }() == 53u, "shift or failed");
+	}
+
+	std::mt19937_64 engine(33);
+	for(int i = 0; i < 100; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		const TypeParam b = random<TypeParam>(engine);
+		const TypeParam c = random<TypeParam>(engine);
+		const std::size_t n = engine() % TypeParam::bit_size;
+		EXPECT_EQ(evaluate(lazy(a) * b + c), a * b + c);
+		EXPECT_EQ(evaluate(c + lazy(a) * b), a * b + c);
+		EXPECT_EQ(evaluate(lazy(a) + b - c), a + b - c);
+		EXPECT_EQ(evaluate((lazy(a) << n) | b), (a << n) | b);
+		EXPECT_EQ(evaluate(b | (lazy(a) << n)), (a << n) | b);
+	}
+
+	EXPECT_EQ(evaluate(lazy(TypeParam::max()) * TypeParam::max() + TypeParam::max()), TypeParam::max() * TypeParam::max() + TypeParam::max());
+	EXPECT_EQ(evaluate(lazy(TypeParam::max()) + 1u - 1u), TypeParam::max());
+	EXPECT_EQ(evaluate(lazy(TypeParam(0u)) + 0u - 1u), TypeParam::max() + TypeParam::max() + 1u);
+	EXPECT_EQ(evaluate(lazy(TypeParam(0u)) * 0u + TypeParam::max()), TypeParam::max());
+}
+
+TYPED_TEST(BigIntegerTests, ExpressionFusedShapes)
+{
+	using expression::fused;
+	using expression::fusion;
+	const TypeParam a, b, c, d;
+	static_assert(fused<decltype(lazy(a) * b + c)>::value == fusion::mul_add, "mul add not fused");
+	static_assert(fused<decltype(c + lazy(a) * b)>::value == fusion::mul_add, "mul add not fused");
+	static_assert(fused<decltype(lazy(a) * b + c - d)>::value == fusion::mul_add_sub, "mul add sub not fused");
+	static_assert(fused<decltype(c + lazy(a) * b - d)>::value == fusion::mul_add_sub, "mul add sub not fused");
+	static_assert(fused<decltype(lazy(a) * b - d)>::value == fusion::mul_add_sub, "mul sub not fused");
+	static_assert(fused<decltype(lazy(a) + b - c)>::value == fusion::add_sub, "add sub not fused");
+	static_assert(fused<decltype((lazy(a) << 3u) | b)>::value == fusion::shl_or, "shift or not fused");
+	static_assert(fused<decltype(lazy(a) - b * c)>::value == fusion::none, "subtracted product fused");
+
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert([]{ TypeParam a(3u), b(5u), c(7u), d(9u); return evaluate(lazy(a) * b + c - d); }() == 13u, "mul add sub failed");
+		static_assert([]{ TypeParam a(3u), b(5u), d(9u); return evaluate(lazy(a) * b - d); }() == 6u, "mul sub failed");
+	}
+
+	std::mt19937_64 engine(46);
+	for(int i = 0; i < 100; i++)
+	{
+		const TypeParam w = random<TypeParam>(engine);
+		const TypeParam x = random<TypeParam>(engine);
+		const TypeParam y = random<TypeParam>(engine);
+		const TypeParam z = random<TypeParam>(engine);
+		EXPECT_EQ(evaluate(lazy(w) * x + y - z), w * x + y - z);
+		EXPECT_EQ(evaluate(y + lazy(w) * x - z), w * x + y - z);
+		EXPECT_EQ(evaluate(lazy(w) * x - z), w * x - z);
+	}
+	EXPECT_EQ(evaluate(lazy(TypeParam(0u)) * 0u - 1u), TypeParam(0u) - 1u);
+	EXPECT_EQ(evaluate(lazy(TypeParam::max()) * TypeParam::max() + 0u - TypeParam::max()), TypeParam::max() * TypeParam::max() - TypeParam::max());
+}
+
+TYPED_TEST(BigIntegerTests, ExpressionChain)
+{
+	std::mt19937_64 engine(34);
+	for(int i = 0; i < 50; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		const TypeParam b = random<TypeParam>(engine);
+		const TypeParam c = random<TypeParam>(engine);
+		const TypeParam d = random<TypeParam>(engine);
+		TypeParam result;
+		assign(result, lazy(a) * b + c - d);
+		EXPECT_EQ(result, a * b + c - d);
+		EXPECT_EQ(evaluate((lazy(a) - b) * (lazy(c) + d)), (a - b) * (c + d));
+		EXPECT_EQ(evaluate((lazy(a) & b) ^ (lazy(c) >> 7u)), (a & b) ^ (c >> 7u));
+		const TypeParam converted = lazy(a) * b + c * d;
+		EXPECT_EQ(converted, a * b + c * d);
+	}
+}
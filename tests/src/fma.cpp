@@ -0,0 +1,100 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+#include <vector>
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+/// Sign or zero extend to the double width type
+template<typename T>
+static double_width_t<T> extend(const T & n)
+{
+	const auto words = n.to_words();
+	std::array<uint64_t, 2 * T::word_count> wide{};
+	if(n < T(0u))
+	{
+		wide.fill(~uint64_t(0));
+	}
+	std::copy(words.begin(), words.end(), wide.begin());
+	return double_width_t<T>::from_words(wide);
+}
+
+TYPED_TEST(BigIntegerTests, Fma)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(fma(TypeParam(3u), TypeParam(5u), TypeParam(7u)) == 22u, "fma failed");
+		static_assert(fma_wide(TypeParam(3u), TypeParam(5u), TypeParam(7u)) == 22u, "wide fma failed");
+	}
+
+	EXPECT_EQ(fma(TypeParam::max(), TypeParam::max(), TypeParam::max()), TypeParam::max() * TypeParam::max() + TypeParam::max());
+	EXPECT_EQ(fma(TypeParam(0u), TypeParam::max(), TypeParam::max()), TypeParam::max());
+	EXPECT_EQ(fma_wide(TypeParam::max(), TypeParam::max(), TypeParam::max()), extend(TypeParam::max()) * extend(TypeParam::max()) + extend(TypeParam::max()));
+	EXPECT_EQ(fma_wide(TypeParam::min(), TypeParam::min(), TypeParam::min()), extend(TypeParam::min()) * extend(TypeParam::min()) + extend(TypeParam::min()));
+
+	std::mt19937_64 engine(34);
+	for(int i = 0; i < 100; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		const TypeParam b = random<TypeParam>(engine);
+		const TypeParam c = random<TypeParam>(engine);
+		EXPECT_EQ(fma(a, b, c), a * b + c);
+		EXPECT_EQ(fma_wide(a, b, c), extend(a) * extend(b) + extend(c));
+	}
+}
+
+TYPED_TEST(BigIntegerTests, Dot)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert([]{
+			const std::array<TypeParam,2> a = {TypeParam(2u), TypeParam(3u)};
+			const std::array<TypeParam,2> b = {TypeParam(5u), TypeParam(7u)};
+			return dot(std::span<const TypeParam>(a), std::span<const TypeParam>(b));
+		}() == 31u, "dot failed");
+	}
+
+	std::mt19937_64 engine(35);
+	std::vector<TypeParam> a, b;
+	TypeParam expected(0u);
+	EXPECT_EQ(dot(std::span(a), std::span(b)), 0u);
+	for(int i = 0; i < 200; i++)
+	{
+		a.push_back(random<TypeParam>(engine));
+		b.push_back(random<TypeParam>(engine));
+		expected += a.back() * b.back();
+		EXPECT_EQ(dot(std::span<const TypeParam>(a), std::span<const TypeParam>(b)), expected);
+	}
+
+	/// carries of all columns
+	std::vector<TypeParam> m;
+	TypeParam sum(0u);
+	for(int i = 0; i < 50; i++)
+	{
+		m.push_back(~TypeParam(0u));
+		sum += ~TypeParam(0u) * ~TypeParam(0u);
+	}
+	EXPECT_EQ(dot(std::span(m), std::span(m)), sum);
+	b.resize(10);
+	EXPECT_THROW(dot(std::span(m), std::span(b)), std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+TYPED_TEST(BigIntegerTests, Hash)
+{
+	std::hash<TypeParam> hasher;
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(std::hash<TypeParam>{}(TypeParam(42u)) == std::hash<TypeParam>{}(TypeParam(42u)), "Hash failed");
+		static_assert(std::hash<TypeParam>{}(TypeParam(42u)) != std::hash<TypeParam>{}(TypeParam(43u)), "Hash failed");
+	}
+
+	EXPECT_EQ(hasher(TypeParam(12345u)), hasher(TypeParam(12345u)));
+
+	/// no collisions for sequential and single bit keys
+	std::unordered_set<std::size_t> hashes;
+	for(unsigned i = 0; i < 1000; i++)
+	{
+		hashes.insert(hasher(TypeParam(i)));
+	}
+	for(std::size_t i = 0; i < TypeParam::bit_size; i++)
+	{
+		hashes.insert(hasher(TypeParam(1u) << i));
+	}
+	EXPECT_EQ(hashes.size(), 1000u + TypeParam::bit_size - 10u);
+
+	/// avalanche: a flipped input bit flips about half of the output bits
+	std::mt19937_64 engine(1);
+	std::size_t flipped = 0;
+	std::size_t samples = 0;
+	for(int k = 0; k < 16; k++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		for(std::size_t i = 0; i < TypeParam::bit_size; i++)
+		{
+			flipped += std::popcount(hasher(a) ^ hasher(TypeParam(a).flip(i)));
+			samples++;
+		}
+	}
+	const double ratio = static_cast<double>(flipped) / static_cast<double>(samples * 64);
+	EXPECT_NEAR(ratio, 0.5, 0.02);
+
+	std::unordered_map<TypeParam,int> map;
+	map.emplace(TypeParam(7u), 7);
+	map.emplace(TypeParam::max(), 1);
+	EXPECT_EQ(map.at(TypeParam(7u)), 7);
+	EXPECT_EQ(map.at(TypeParam::max()), 1);
+	EXPECT_EQ(map.count(TypeParam(8u)), 0u);
+}
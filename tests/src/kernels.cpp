@@ -0,0 +1,240 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+#include <vector>
+
+#include "testbiginteger.h"
+#include "kernels.h"
+
+static constexpr bool proof_const = true;
+
+/// Every variant the CPU supports against the portable kernels
+TEST(Kernels, Variants)
+{
+	std::mt19937_64 engine(2020);
+	const auto & cpu = kernels::cpu();
+	for(std::size_t n = 1; n <= 40; n++)
+	{
+		std::vector<uint64_t> a(n), b(n), r(n), expected(n), result(n);
+		for(int round = 0; round < 20; round++)
+		{
+			for(std::size_t i = 0; i < n; i++)
+			{
+				/// all ones and zeros words make long carry chains
+				a[i] = round % 4 == 0 ? ~uint64_t(0) : engine();
+				b[i] = round % 4 == 1 ? 0 : round % 4 == 2 ? 1 : engine();
+				r[i] = engine();
+			}
+
+			expected = r;
+			kernels::generic::mul_add(expected.data(), a.data(), b.data(), n);
+			result = r;
+			kernels::mul_add(result.data(), a.data(), b.data(), n);
+			EXPECT_EQ(result, expected);
+
+			const uint64_t carry = kernels::generic::add(expected.data(), a.data(), b.data(), n);
+			EXPECT_EQ(kernels::add(result.data(), a.data(), b.data(), n), carry);
+			EXPECT_EQ(result, expected);
+
+			const uint64_t borrow = kernels::generic::sub(expected.data(), a.data(), b.data(), n);
+			EXPECT_EQ(kernels::sub(result.data(), a.data(), b.data(), n), borrow);
+			EXPECT_EQ(result, expected);
+
+#if defined(__x86_64__)
+			if(cpu.bmi2 && cpu.adx)
+			{
+				kernels::generic::mul_add(expected.data(), a.data(), b.data(), n);
+				kernels::adx::mul_add(result.data(), a.data(), b.data(), n);
+				EXPECT_EQ(result, expected);
+				EXPECT_EQ(kernels::adx::add(result.data(), a.data(), b.data(), n), kernels::generic::add(expected.data(), a.data(), b.data(), n));
+				EXPECT_EQ(result, expected);
+				EXPECT_EQ(kernels::adx::sub(result.data(), a.data(), b.data(), n), kernels::generic::sub(expected.data(), a.data(), b.data(), n));
+				EXPECT_EQ(result, expected);
+			}
+			if(cpu.avx512f)
+			{
+				EXPECT_EQ(kernels::avx512::add(result.data(), a.data(), b.data(), n), kernels::generic::add(expected.data(), a.data(), b.data(), n));
+				EXPECT_EQ(result, expected);
+				EXPECT_EQ(kernels::avx512::sub(result.data(), a.data(), b.data(), n), kernels::generic::sub(expected.data(), a.data(), b.data(), n));
+				EXPECT_EQ(result, expected);
+			}
+#endif
+		}
+	}
+}
+
+/// Batch Montgomery products against the product of the operators
+TEST(Kernels, MontgomeryBatch)
+{
+	std::mt19937_64 engine(2020);
+	/// the largest size is the kernel limit
+	static_assert(kernels::montgomery_max_words == 64);
+	for(std::size_t n : {1u, 2u, 4u, 8u, 13u, 16u, 63u, 64u})
+	{
+		const std::size_t count = 11;
+		std::vector<uint64_t> m(n), a(n * count), b(n * count), expected(n * count), result(n * count);
+		for(auto & w : m)
+		{
+			w = engine();
+		}
+		m[0] |= 1;
+		m[n-1] |= uint64_t(1) << 63;
+		uint64_t inv = m[0];
+		for(int i = 0; i < 5; i++)
+		{
+			inv *= 2 - m[0] * inv;
+		}
+		for(std::size_t k = 0; k < n * count; k += n)
+		{
+			for(std::size_t j = 0; j < n; j++)
+			{
+				a[k+j] = engine();
+				b[k+j] = k == 0 ? m[j] : engine();
+			}
+			/// below m
+			a[k+n-1] >>= 1;
+			b[k+n-1] >>= k == 0 ? 0 : 1;
+		}
+		b[0] -= 1;
+
+		kernels::generic::montgomery_mul_batch(expected.data(), a.data(), b.data(), m.data(), -inv, n, count);
+		kernels::montgomery_mul_batch(result.data(), a.data(), b.data(), m.data(), -inv, n, count);
+		EXPECT_EQ(result, expected) << n;
+#if defined(__x86_64__)
+		if(kernels::cpu().avx512ifma)
+		{
+			kernels::avx512ifma::montgomery_mul_batch(result.data(), a.data(), b.data(), m.data(), -inv, n, count);
+			EXPECT_EQ(result, expected) << n;
+		}
+#endif
+		if(n == 8)
+		{
+			/// the generic kernel against the 512 bit product and remainder
+			const auto value = [](const uint64_t * w) {
+				std::array<uint64_t,16> words{};
+				std::copy(w, w + 8, words.begin());
+				return uint1024_t::from_words(words);
+			};
+			for(std::size_t k = 0; k < n * count; k += n)
+			{
+				const uint1024_t product = value(a.data() + k) * value(b.data() + k);
+				EXPECT_EQ((value(expected.data() + k) << 512u) % value(m.data()), product % value(m.data()));
+			}
+		}
+	}
+}
+
+TEST(Kernels, Clmul)
+{
+	std::mt19937_64 engine(2020);
+	for(std::size_t n = 1; n <= 20; n++)
+	{
+		std::vector<uint64_t> a(n), b(n), expected(2 * n), result(2 * n, 1);
+		for(std::size_t i = 0; i < n; i++)
+		{
+			a[i] = engine();
+			b[i] = engine();
+		}
+		kernels::generic::clmul(expected.data(), a.data(), b.data(), n);
+		kernels::clmul(result.data(), a.data(), b.data(), n);
+		EXPECT_EQ(result, expected) << n;
+#if defined(__x86_64__)
+		if(kernels::cpu().pclmulqdq)
+		{
+			kernels::pclmul::clmul(result.data(), a.data(), b.data(), n);
+			EXPECT_EQ(result, expected) << n;
+		}
+#endif
+	}
+}
+
+TEST(Kernels, CompareBatch)
+{
+	std::mt19937_64 engine(2020);
+	for(std::size_t n : {1u, 2u, 3u, 4u, 5u, 8u, 9u, 16u, 64u, 65u, 130u})
+	{
+		const std::size_t count = 50;
+		std::vector<uint64_t> a(n * count), b(n * count);
+		for(std::size_t i = 0; i < n * count; i++)
+		{
+			a[i] = engine();
+			b[i] = a[i];
+		}
+		/// pairs that differ in one word, with the sign bit or only the low bits
+		for(std::size_t k = 1; k < count; k++)
+		{
+			const std::size_t i = k * n + engine() % n;
+			b[i] ^= k % 3 == 0 ? uint64_t(1) << 63 : k % 3 == 1 ? 1 : engine();
+		}
+		for(const bool is_signed : {false, true})
+		{
+			std::vector<int8_t> expected(count), result(count);
+			kernels::generic::compare_batch(expected.data(), a.data(), b.data(), n, count, is_signed);
+			EXPECT_EQ(expected[0], 0);
+			kernels::compare_batch(result.data(), a.data(), b.data(), n, count, is_signed);
+			EXPECT_EQ(result, expected) << n;
+#if defined(__x86_64__)
+			if(kernels::cpu().avx2)
+			{
+				kernels::avx2::compare_batch(result.data(), a.data(), b.data(), n, count, is_signed);
+				EXPECT_EQ(result, expected) << n;
+			}
+			if(kernels::cpu().avx512f)
+			{
+				kernels::avx512::compare_batch(result.data(), a.data(), b.data(), n, count, is_signed);
+				EXPECT_EQ(result, expected) << n;
+			}
+#endif
+		}
+	}
+}
+
+TYPED_TEST(BigIntegerTests, AddMany)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert([] {
+			const std::array<TypeParam,2> a = {TypeParam::max(), TypeParam(5u)};
+			const std::array<TypeParam,2> b = {TypeParam(1u), TypeParam(3u)};
+			std::array<TypeParam,2> out;
+			add_many(std::span<const TypeParam>(a), std::span<const TypeParam>(b), std::span<TypeParam>(out));
+			sub_many(std::span<const TypeParam>(out), std::span<const TypeParam>(b), std::span<TypeParam>(out));
+			return out[0] == TypeParam::max() && out[1] == 5u;
+		}(), "Add many failed");
+	}
+
+	std::mt19937_64 engine(2020);
+	std::vector<TypeParam> a, b, sums(100), differences(100);
+	for(std::size_t i = 0; i < 100; i++)
+	{
+		a.push_back(i % 3 == 0 ? TypeParam::max() : random<TypeParam>(engine));
+		b.push_back(i % 3 == 1 ? TypeParam(1u) : random<TypeParam>(engine));
+	}
+	add_many(std::span(a), std::span(b), std::span(sums));
+	sub_many(std::span(a), std::span(b), std::span(differences));
+	for(std::size_t i = 0; i < 100; i++)
+	{
+		EXPECT_EQ(sums[i], a[i] + b[i]);
+		EXPECT_EQ(differences[i], a[i] - b[i]);
+	}
+
+	std::vector<TypeParam> shorter(99);
+	EXPECT_THROW(add_many(std::span(a), std::span(b), std::span(shorter)), std::invalid_argument);
+}
@@ -122,3 +122,12 @@ TYPED_TEST(BigIntegerTests, Multiply)
 	EXPECT_EQ(b2*a2, c2);
 	EXPECT_EQ(a2*b2, c2);
 }
+
+TYPED_TEST(BigIntegerTests, MultiplyCarryChain)
+{
+	/// (2^n - 5)^2 = 2^2n - 10 * 2^n + 25
+	const std::size_t n = TypeParam::bit_size / 2 - 4;
+	TypeParam x = TypeParam(1u) << n;
+	TypeParam a = x - 5u;
+	EXPECT_EQ(a * a, (x << n) - x * 10u + 25u);
+}
@@ -0,0 +1,48 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// Compiled with -fno-exceptions, the build fails if the headers need exceptions
+
+#include "biginteger.h"
+#include "accumulator.h"
+#include "bigintegerio.h"
+#include "expression.h"
+#include "numbertheory.h"
+#include "rnsinteger.h"
+
+using namespace biginteger;
+
+static_assert([]{
+	uint512_t q, rem;
+	return divmod(uint512_t(17u), uint512_t(5u), q, rem) == std::errc() && q == 3u && rem == 2u;
+}(), "Divmod failed");
+
+static_assert([]{
+	uint512_t q, rem;
+	return divmod(uint512_t(17u), uint512_t(0u), q, rem) == std::errc::invalid_argument;
+}(), "Divmod by zero failed");
+
+std::errc divide(const int512_t & l, const int512_t & r, int512_t & q, int512_t & rem) noexcept
+{
+	return divmod(l, r, q, rem);
+}
+
+uint1024_t quotient(const uint1024_t & l, const uint1024_t & r)
+{
+	return l / r;
+}
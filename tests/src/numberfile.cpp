@@ -0,0 +1,158 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+#include "testbiginteger.h"
+#include "numberfile.h"
+
+static constexpr bool proof_const = true;
+
+static std::string to_text(uint256_t v, bool hex)
+{
+	/// 16 hex or 19 decimal digits per division
+	const uint64_t base = hex ? uint64_t(1) << 60 : 10000000000000000000u;
+	std::string text;
+	do
+	{
+		char digits[24];
+		const uint64_t chunk = (v % base).to_words()[0];
+		v /= base;
+		std::snprintf(digits, sizeof(digits), hex ? "%015llx" : "%019llu", static_cast<unsigned long long>(chunk));
+		text.insert(0, digits);
+	}
+	while(v);
+	text.erase(0, std::min(text.find_first_not_of('0'), text.size() - 1));
+	return hex ? "0x" + text : text;
+}
+
+TEST(NumberFile, ParseNumber)
+{
+	uint256_t u;
+	EXPECT_TRUE(detail::parse_number(" 12345678901234567890123456789\r", u));
+	EXPECT_EQ(u, uint256_t(12345678901234567890u) * 1000000000u + 123456789u);
+	EXPECT_TRUE(detail::parse_number("0xFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFff", u));
+	EXPECT_EQ(u, ~uint256_t(0u));
+	EXPECT_TRUE(detail::parse_number("115792089237316195423570985008687907853269984665640564039457584007913129639935", u));
+	EXPECT_EQ(u, ~uint256_t(0u));
+	EXPECT_TRUE(detail::parse_number("0x000000000000000000000000000000000000000000000000000000000000000000001", u));
+	EXPECT_EQ(u, 1u);
+	EXPECT_FALSE(detail::parse_number("115792089237316195423570985008687907853269984665640564039457584007913129639936", u));
+	EXPECT_FALSE(detail::parse_number("0x1FFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFffFFff", u));
+	EXPECT_FALSE(detail::parse_number("", u));
+	EXPECT_FALSE(detail::parse_number("0x", u));
+	EXPECT_FALSE(detail::parse_number("-1", u));
+	EXPECT_FALSE(detail::parse_number("12a", u));
+	EXPECT_FALSE(detail::parse_number("1 2", u));
+	/// a bad character at every position of the 8 digit groups, spaces only inside
+	for(std::size_t i = 0; i < 40; i++)
+	{
+		for(const char c : {'/', ':', 'a', ' '})
+		{
+			std::string digits(40, '7');
+			digits[i] = c;
+			EXPECT_EQ(detail::parse_number(digits, u), c == ' ' && (i == 0 || i == 39));
+		}
+	}
+	for(std::size_t i = 2; i < 66; i++)
+	{
+		for(const char c : {'/', ':', '@', 'G', '`', 'g', '\x10', '\x19', '\xb0'})
+		{
+			std::string digits = "0x" + std::string(64, 'a');
+			digits[i] = c;
+			EXPECT_FALSE(detail::parse_number(digits, u));
+		}
+	}
+
+	int512_t s;
+	EXPECT_TRUE(detail::parse_number("-0x8" + std::string(127, '0'), s));
+	EXPECT_EQ(s, int512_t(1u) << 511u);
+	EXPECT_FALSE(detail::parse_number("0x8" + std::string(127, '0'), s));
+	EXPECT_TRUE(detail::parse_number("-42", s));
+	EXPECT_EQ(s, -42);
+
+	static_assert(proof_const && [] {
+		uint192_t v;
+		return detail::parse_number("0x1234", v) && v == 0x1234u;
+	}());
+}
+
+TEST(NumberFile, Parallel)
+{
+	std::mt19937_64 engine(2020);
+	std::vector<uint256_t> expected;
+	std::vector<std::size_t> malformed{1};
+	std::string text = "key,value\n";
+	std::size_t line = 1;
+	while(text.size() < (5u << 20))
+	{
+		const uint256_t v = random<uint256_t>(engine);
+		line++;
+		if(line % 1000 == 0)
+		{
+			text += "7,not a number\n";
+			malformed.push_back(line);
+		}
+		else if(line % 777 == 0)
+		{
+			text += "\r\n";
+		}
+		else
+		{
+			text += std::to_string(line) + (line % 2 ? ", " + to_text(v, false) + "\r\n" : "," + to_text(v, true) + "\n");
+			expected.push_back(v);
+		}
+	}
+	text += "1,42";
+	expected.push_back(42u);
+
+	NumberFileOptions options;
+	options.column = 1;
+	for(const unsigned threads : {1u, 3u, 8u})
+	{
+		options.threads = threads;
+		const NumberFile<uint256_t> result = parse_numbers<uint256_t>(text, options);
+		EXPECT_TRUE(result.values == expected);
+		EXPECT_EQ(result.malformed, malformed);
+	}
+	EXPECT_TRUE(detail::split_lines(text, 4).size() <= 4);
+
+	/// the first column holds the line numbers
+	options.column = 0;
+	const NumberFile<uint192_t> lines = parse_numbers<uint192_t>(text, options);
+	EXPECT_EQ(lines.malformed, std::vector<std::size_t>{1});
+	EXPECT_EQ(lines.values[1], 3u);
+}
+
+TEST(NumberFile, Read)
+{
+	const std::string path = (std::filesystem::temp_directory_path() / "biginteger_numbers.txt").string();
+	std::ofstream(path) << "1\n0x10\n\nx\n-1\n";
+	const NumberFile<int192_t> file = read_numbers<int192_t>(path);
+	EXPECT_EQ(file.values, (std::vector<int192_t>{1, 16, -1}));
+	EXPECT_EQ(file.malformed, std::vector<std::size_t>{4});
+
+	std::ofstream(path).close();
+	EXPECT_TRUE(read_numbers<uint256_t>(path).values.empty());
+	std::remove(path.c_str());
+	EXPECT_THROW(read_numbers<uint256_t>(path), std::system_error);
+}
@@ -0,0 +1,114 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+TYPED_TEST(BigIntegerTests, Overflow)
+{
+	constexpr bool is_signed = TypeParam::min() < 0u;
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(add_overflow(TypeParam::max(), TypeParam(1u)).second, "Add overflow failed");
+		static_assert(!add_overflow(TypeParam::max() - 1u, TypeParam(1u)).second, "Add overflow failed");
+		static_assert(sub_overflow(TypeParam::min(), TypeParam(1u)).second, "Sub overflow failed");
+		static_assert(mul_overflow(TypeParam::max(), TypeParam(2u)).second, "Mul overflow failed");
+		static_assert(mul_overflow(TypeParam(3u), TypeParam(5u)).first == 15u, "Mul overflow failed");
+	}
+
+	EXPECT_EQ(add_overflow(TypeParam::max(), TypeParam(1u)).first, TypeParam::min());
+	EXPECT_FALSE(add_overflow(TypeParam::max(), TypeParam(0u)).second);
+	EXPECT_FALSE(sub_overflow(TypeParam::max(), TypeParam::max()).second);
+	EXPECT_EQ(sub_overflow(TypeParam::min(), TypeParam(1u)).first, TypeParam::max());
+	EXPECT_FALSE(mul_overflow(TypeParam::max(), TypeParam(1u)).second);
+	EXPECT_FALSE(mul_overflow(TypeParam::max(), TypeParam(0u)).second);
+	EXPECT_TRUE(mul_overflow(TypeParam(1u) << (TypeParam::bit_size / 2), TypeParam(1u) << (TypeParam::bit_size / 2)).second);
+	EXPECT_FALSE(mul_overflow(TypeParam(1u) << (TypeParam::bit_size / 2 - 1), TypeParam(1u) << (TypeParam::bit_size / 2 - 2)).second);
+	EXPECT_EQ(mul_overflow(TypeParam::max(), TypeParam::max()).second, true);
+	if constexpr(is_signed)
+	{
+		const TypeParam minus_one = TypeParam(0u) - 1u;
+		EXPECT_TRUE(add_overflow(TypeParam::min(), minus_one).second);
+		EXPECT_FALSE(add_overflow(TypeParam::max(), minus_one).second);
+		EXPECT_TRUE(sub_overflow(TypeParam::max(), minus_one).second);
+		EXPECT_FALSE(sub_overflow(minus_one, TypeParam::max()).second);
+		EXPECT_TRUE(mul_overflow(TypeParam::min(), minus_one).second);
+		EXPECT_FALSE(mul_overflow(TypeParam::max(), minus_one).second);
+		/// min() is reachable only with a negative product
+		const TypeParam half = TypeParam(1u) << (TypeParam::bit_size - 2);
+		EXPECT_FALSE(mul_overflow(half, TypeParam(0u) - 2u).second);
+		EXPECT_EQ(mul_overflow(half, TypeParam(0u) - 2u).first, TypeParam::min());
+		EXPECT_TRUE(mul_overflow(half, TypeParam(2u)).second);
+	}
+
+	/// compare with the double width product
+	std::mt19937_64 engine(38);
+	for(int i = 0; i < 100; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine) >> (engine() % TypeParam::bit_size);
+		const TypeParam b = random<TypeParam>(engine) >> (engine() % TypeParam::bit_size);
+		const auto wide = fma_wide(a, b, TypeParam(0u));
+		const auto [product, overflow] = mul_overflow(a, b);
+		EXPECT_EQ(product, a * b);
+		EXPECT_EQ(overflow, wide != fma_wide(product, TypeParam(1u), TypeParam(0u)));
+		EXPECT_EQ(add_overflow(a, b).first, a + b);
+		EXPECT_EQ(sub_overflow(a, b).first, a - b);
+		if constexpr(!is_signed)
+		{
+			EXPECT_EQ(add_overflow(a, b).second, a + b < a);
+			EXPECT_EQ(sub_overflow(a, b).second, a < b);
+		}
+	}
+}
+
+TYPED_TEST(BigIntegerTests, Saturate)
+{
+	constexpr bool is_signed = TypeParam::min() < 0u;
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(add_sat(TypeParam::max(), TypeParam(5u)) == TypeParam::max(), "Saturated add failed");
+		static_assert(sub_sat(TypeParam::min(), TypeParam(5u)) == TypeParam::min(), "Saturated sub failed");
+		static_assert(mul_sat(TypeParam::max(), TypeParam(5u)) == TypeParam::max(), "Saturated mul failed");
+	}
+
+	EXPECT_EQ(add_sat(TypeParam(3u), TypeParam(5u)), 8u);
+	EXPECT_EQ(sub_sat(TypeParam(8u), TypeParam(5u)), 3u);
+	EXPECT_EQ(mul_sat(TypeParam(3u), TypeParam(5u)), 15u);
+	EXPECT_EQ(add_sat(TypeParam::max() - 1u, TypeParam::max()), TypeParam::max());
+	EXPECT_EQ(mul_sat(TypeParam::max(), TypeParam::max()), TypeParam::max());
+	if constexpr(is_signed)
+	{
+		const TypeParam minus_one = TypeParam(0u) - 1u;
+		EXPECT_EQ(sub_sat(TypeParam(3u), TypeParam(5u)), TypeParam(0u) - 2u);
+		EXPECT_EQ(add_sat(TypeParam::min(), minus_one), TypeParam::min());
+		EXPECT_EQ(sub_sat(TypeParam::max(), minus_one), TypeParam::max());
+		EXPECT_EQ(sub_sat(TypeParam::min() + 1u, TypeParam::max()), TypeParam::min());
+		EXPECT_EQ(mul_sat(TypeParam::min(), minus_one), TypeParam::max());
+		EXPECT_EQ(mul_sat(TypeParam::max(), TypeParam(0u) - 2u), TypeParam::min());
+	}
+	else
+	{
+		EXPECT_EQ(sub_sat(TypeParam(3u), TypeParam(5u)), 0u);
+		EXPECT_EQ(sub_sat(TypeParam(0u), TypeParam::max()), 0u);
+	}
+}
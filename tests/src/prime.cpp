@@ -0,0 +1,232 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+template<typename T>
+constexpr T make(uint64_t hi, uint64_t lo)
+{
+	return (T(hi) << 64u) | T(lo);
+}
+
+template<typename T>
+constexpr T mersenne(std::size_t p)
+{
+	return (T(1u) << p) - 1u;
+}
+
+/// Random odd modulus with the top bit of the positive range set
+template<typename T>
+T odd_modulus(std::mt19937_64 & engine)
+{
+	return ((T::max() >> 1u) - (random<T>(engine) >> 3u)) | 1u;
+}
+
+TYPED_TEST(BigIntegerTests, Words)
+{
+	std::array<uint64_t,TypeParam::word_count> words{};
+	for(std::size_t i = 0; i < words.size(); i++)
+	{
+		words[i] = 0x0123456789abcdefu * (i + 1);
+	}
+	TypeParam a = TypeParam::from_words(words);
+	EXPECT_EQ(a.to_words(), words);
+	EXPECT_EQ(a & TypeParam(~uint64_t(0)), TypeParam(words[0]));
+	EXPECT_EQ(a >> (TypeParam::bit_size - 64), TypeParam(words.back()));
+}
+
+TYPED_TEST(BigIntegerTests, PowerModulo)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(powmod(TypeParam(3u), TypeParam(200u), TypeParam(1000000007u)) == TypeParam(136318165u), "Power modulo failed");
+	}
+
+	const TypeParam m = mersenne<TypeParam>(127);
+	EXPECT_EQ(powmod(TypeParam(3u), make<TypeParam>(0x5u, 0x6bc75e2d63100007u), m), make<TypeParam>(0x4901b9c4923dd3ccu, 0x5c5db62d90e71153u));
+	EXPECT_EQ(powmod(TypeParam(0x123456789abcdefu), TypeParam(0xfedcba987654321u), make<TypeParam>(uint64_t(1) << 62, 12345678u)),
+			make<TypeParam>(0x118ed756a4fcfee4u, 0xe17dab2dcc2deb55u));
+	EXPECT_EQ(powmod(TypeParam(0x123456789abcdefu), TypeParam(0xfedcba987654321u), make<TypeParam>(uint64_t(1) << 62, 12345677u)),
+			make<TypeParam>(0x1b8467e52c526e5cu, 0xdaf7efe7fda7d3b4u));
+
+	EXPECT_EQ(powmod(TypeParam(3u), TypeParam(200u), TypeParam(1000000008u)), 323520633u);
+	EXPECT_EQ(powmod(TypeParam(5u), TypeParam(0u), TypeParam(7u)), 1u);
+	EXPECT_EQ(powmod(TypeParam(5u), TypeParam(0u), TypeParam(1u)), 0u);
+	EXPECT_EQ(powmod(TypeParam(5u), TypeParam(3u), TypeParam(1u)), 0u);
+	EXPECT_THROW(powmod(TypeParam(5u), TypeParam(3u), TypeParam(0u)), std::invalid_argument);
+
+	/// Fermat on a modulus with the top bit set
+	if constexpr(TypeParam(0u) < ~TypeParam(0u))
+	{
+		const TypeParam p = TypeParam::max() - 58u;
+		EXPECT_EQ(powmod(TypeParam(2u), p - 1u, p) == TypeParam(1u), is_probable_prime(p));
+	}
+}
+
+TYPED_TEST(BigIntegerTests, Montgomery)
+{
+	const TypeParam m = mersenne<TypeParam>(89);
+	Montgomery<TypeParam> mont(m);
+	const TypeParam a = 0xfedcba9876543210u;
+	const TypeParam b = 0x0123456789abcdefu;
+	EXPECT_EQ(mont.from_montgomery(mont.to_montgomery(a)), a);
+	EXPECT_EQ(mont.from_montgomery(mont.one()), 1u);
+	EXPECT_EQ(mont.from_montgomery(mont.mul(mont.to_montgomery(a), mont.to_montgomery(b))), (a * b) % m);
+	EXPECT_THROW(Montgomery<TypeParam>(TypeParam(10u)), std::invalid_argument);
+}
+
+TYPED_TEST(BigIntegerTests, MontgomeryMany)
+{
+	std::mt19937_64 engine(2020);
+	const TypeParam m = odd_modulus<TypeParam>(engine);
+	Montgomery<TypeParam> mont(m);
+	std::vector<TypeParam> a, b, out(37);
+	for(std::size_t i = 0; i < out.size(); i++)
+	{
+		a.push_back(i == 0 ? m - 1u : random_below(engine, m));
+		b.push_back(i == 1 ? TypeParam(0u) : random_below(engine, m));
+	}
+	mont.mul_many(a, b, out);
+	for(std::size_t i = 0; i < out.size(); i++)
+	{
+		EXPECT_EQ(out[i], mont.mul(a[i], b[i])) << i;
+	}
+	EXPECT_THROW(mont.mul_many(a, b, std::span(out).first(36)), std::invalid_argument);
+}
+
+TYPED_TEST(BigIntegerTests, FixedBasePow)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(FixedBasePow<TypeParam>(TypeParam(3u), TypeParam(1000003u), 16).pow(TypeParam(12345u)) == 968488u,
+				"Fixed base power failed");
+	}
+
+	std::mt19937_64 engine(2020);
+	const TypeParam m = odd_modulus<TypeParam>(engine);
+	const TypeParam g = random_below(engine, m);
+	const TypeParam h = random_below(engine, m);
+	const FixedBasePow<TypeParam> table_g(g, m);
+	const FixedBasePow<TypeParam> table_h(h, m, TypeParam::bit_size - 1, 5);
+	for(int i = 0; i < 10; i++)
+	{
+		const TypeParam a = i == 0 ? TypeParam(0u) : random_below(engine, m);
+		const TypeParam b = i == 1 ? TypeParam::max() : random<TypeParam>(engine) >> 1u;
+		EXPECT_EQ(table_g.pow(a), powmod(g, a, m));
+		/// b wider than the table of h
+		EXPECT_EQ(table_h.pow(b), powmod(h, b, m));
+		const TypeParam expected = Montgomery<TypeParam>(m).from_montgomery(Montgomery<TypeParam>(m).mul(
+				Montgomery<TypeParam>(m).to_montgomery(powmod(g, a, m)), Montgomery<TypeParam>(m).to_montgomery(powmod(h, b, m))));
+		EXPECT_EQ(table_g.pow(a, table_h, b), expected);
+		const std::array<TypeParam,2> bases = {g, h};
+		const std::array<TypeParam,2> exponents = {a, b};
+		EXPECT_EQ(multi_powmod(std::span<const TypeParam>(bases), std::span<const TypeParam>(exponents), m), expected);
+	}
+
+	const auto data = table_h.serialize();
+	const FixedBasePow<TypeParam> loaded(data);
+	EXPECT_EQ(loaded.pow(m - 2u), table_h.pow(m - 2u));
+	EXPECT_EQ(loaded.serialize(), data);
+	EXPECT_THROW(FixedBasePow<TypeParam>(std::span(data).first(data.size() - 1)), std::invalid_argument);
+	EXPECT_THROW(FixedBasePow<TypeParam>(g, m, TypeParam::bit_size, 0), std::invalid_argument);
+	EXPECT_THROW(table_g.pow(TypeParam(1u), FixedBasePow<TypeParam>(h, m - 2u), TypeParam(1u)), std::invalid_argument);
+}
+
+TYPED_TEST(BigIntegerTests, ProbablePrime)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(is_probable_prime(mersenne<TypeParam>(61), 2), "Prime test failed");
+		static_assert(!is_probable_prime(TypeParam(561u)), "Prime test failed");
+	}
+
+	for(unsigned n : {0u, 1u, 4u, 9u, 561u, 41041u, 825265u, 63001u})
+	{
+		EXPECT_FALSE(is_probable_prime(TypeParam(n))) << n;
+	}
+	for(unsigned n : {2u, 3u, 5u, 251u, 257u, 65537u, 2147483647u})
+	{
+		EXPECT_TRUE(is_probable_prime(TypeParam(n))) << n;
+	}
+	for(std::size_t p : {61u, 89u, 107u, 127u})
+	{
+		EXPECT_TRUE(is_probable_prime(mersenne<TypeParam>(p))) << p;
+	}
+	EXPECT_FALSE(is_probable_prime(mersenne<TypeParam>(67)));
+	EXPECT_FALSE(is_probable_prime(mersenne<TypeParam>(101)));
+
+	/// strong pseudoprime to the bases 2 ... 31
+	const TypeParam spsp = 0x351591274f9af9fbu;
+	EXPECT_TRUE(is_probable_prime(spsp, 11));
+	EXPECT_FALSE(is_probable_prime(spsp, 12));
+
+	std::mt19937_64 engine(42);
+	EXPECT_TRUE(is_probable_prime(mersenne<TypeParam>(127), 10, engine));
+	EXPECT_FALSE(is_probable_prime(spsp, 10, engine));
+
+	if constexpr(TypeParam::bit_size >= 256)
+	{
+		EXPECT_FALSE(is_probable_prime(mersenne<TypeParam>(61) * mersenne<TypeParam>(127)));
+	}
+	if constexpr(TypeParam::bit_size == 1024)
+	{
+		EXPECT_TRUE(is_probable_prime(mersenne<TypeParam>(607)));
+		EXPECT_FALSE(is_probable_prime(mersenne<TypeParam>(601)));
+	}
+}
+
+TYPED_TEST(BigIntegerTests, Random)
+{
+	std::mt19937_64 engine(7);
+	std::minstd_rand narrow_engine(7);
+
+	TypeParam all_or;
+	TypeParam all_and = ~TypeParam(0u);
+	for(int i = 0; i < 64; i++)
+	{
+		TypeParam a = random<TypeParam>(engine);
+		all_or |= a;
+		all_and &= a;
+	}
+	EXPECT_EQ(all_or, ~TypeParam(0u));
+	EXPECT_EQ(all_and, 0u);
+	EXPECT_NE(random<TypeParam>(narrow_engine), random<TypeParam>(narrow_engine));
+
+	const TypeParam bound = (TypeParam(1u) << (TypeParam::bit_size - 2)) + 3u;
+	TypeParam bound_or;
+	for(int i = 0; i < 64; i++)
+	{
+		TypeParam a = random_below(engine, bound);
+		EXPECT_LT(a, bound);
+		EXPECT_GE(a, 0u);
+		bound_or |= a;
+	}
+	EXPECT_EQ(bound_or, (TypeParam(1u) << (TypeParam::bit_size - 2)) - 1u);
+	for(int i = 0; i < 16; i++)
+	{
+		EXPECT_LT(random_below(engine, TypeParam(3u)), 3u);
+	}
+	EXPECT_EQ(random_below(engine, TypeParam(1u)), 0u);
+	EXPECT_THROW(random_below(engine, TypeParam(0u)), std::invalid_argument);
+}
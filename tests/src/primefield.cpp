@@ -0,0 +1,104 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+
+#include "testbiginteger.h"
+#include "primefield.h"
+
+static constexpr bool proof_const = true;
+
+struct Curve25519
+{
+	static constexpr uint256_t value = (uint256_t(1u) << 255u) - 19u;
+};
+
+struct Secp256k1
+{
+	static constexpr uint256_t value = ~uint256_t(0u) - (uint256_t(1u) << 32u) - 976u;
+};
+
+struct P511
+{
+	static constexpr uint512_t value = (uint512_t(1u) << 511u) - 187u;
+};
+
+/// Solinas prime with a 225 bit c, folded with multi word products
+struct Goldilocks
+{
+	static constexpr uint512_t value = (uint512_t(1u) << 448u) - (uint512_t(1u) << 224u) - 1u;
+};
+
+/// Modulus much narrower than its type, values from the constructor exceed 2^(2 k)
+struct Mersenne61
+{
+	static constexpr uint256_t value = (uint256_t(1u) << 61u) - 1u;
+};
+
+template <typename T>
+class PrimeFieldTests : public ::testing::Test {
+};
+
+typedef Types<PrimeField<Curve25519>, PrimeField<Secp256k1>, PrimeField<P511>, PrimeField<Goldilocks>,
+	PrimeField<Mersenne61>> PrimeFieldTypes;
+
+TYPED_TEST_SUITE(PrimeFieldTests, PrimeFieldTypes);
+
+TYPED_TEST(PrimeFieldTests, Arithmetic)
+{
+	using T = typename TypeParam::value_type;
+	const T m = TypeParam::modulus();
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert((TypeParam(TypeParam::modulus() - 1u) + TypeParam(T(2u))).value() == 1u, "Prime field add failed");
+		static_assert((TypeParam(T(1u)) - TypeParam(T(2u))).value() == TypeParam::modulus() - 1u, "Prime field sub failed");
+		static_assert((TypeParam(TypeParam::modulus() - 1u) * TypeParam(TypeParam::modulus() - 1u)).value() == 1u, "Prime field mul failed");
+		static_assert(TypeParam(T(3u)) * TypeParam(T(3u)).inv() == TypeParam(T(1u)), "Prime field inv failed");
+	}
+
+	EXPECT_TRUE(is_probable_prime(m));
+	EXPECT_EQ(TypeParam(m).value(), 0u);
+	EXPECT_EQ(TypeParam(~T(0u)).value(), ~T(0u) % m);
+	EXPECT_THROW(TypeParam().inv(), std::invalid_argument);
+
+	std::mt19937_64 engine(2020);
+	for(int i = 0; i < 50; i++)
+	{
+		const T a = i == 0 ? m - 1u : random_below(engine, m);
+		const T b = i == 0 ? m - 1u : random_below(engine, m);
+		const TypeParam x(a), y(b);
+		const T r = random<T>(engine);
+		EXPECT_EQ(TypeParam(r).value(), r % m);
+		const auto expected = (fma_wide(a, b, T(0u)) % fma_wide(m, T(1u), T(0u))).to_words();
+		std::array<uint64_t,T::word_count> low;
+		std::copy(expected.begin(), expected.begin() + T::word_count, low.begin());
+		EXPECT_EQ((x * y).value(), T::from_words(low));
+		EXPECT_EQ(x.sqr(), x * x);
+		EXPECT_EQ((x + y).value(), a >= m - b ? a - (m - b) : a + b);
+		EXPECT_EQ((x - y).value(), a >= b ? a - b : m - (b - a));
+		EXPECT_EQ((x - y) + y, x);
+		EXPECT_EQ(-x + x, TypeParam());
+		EXPECT_EQ(x.pow(b).value(), powmod(a, b, m));
+		if(a != 0u)
+		{
+			EXPECT_EQ(x * x.inv(), TypeParam(T(1u)));
+			EXPECT_EQ(y / x * x, y);
+		}
+	}
+}
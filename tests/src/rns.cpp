@@ -0,0 +1,98 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+
+#include "testbiginteger.h"
+#include "rnsinteger.h"
+
+static constexpr bool proof_const = true;
+
+TYPED_TEST(BigIntegerTests, RnsConversion)
+{
+	using Rns = RnsInteger<TypeParam>;
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(Rns(TypeParam(12345u)).template to_integer<TypeParam>() == TypeParam(12345u), "RNS conversion failed");
+		static_assert((Rns(TypeParam(3u)) * Rns(TypeParam(5u))).residue(0) == 15u, "RNS product failed");
+	}
+
+	EXPECT_EQ(Rns(TypeParam(0u)).to_integer(), 0u);
+	EXPECT_EQ(Rns(TypeParam::max()).to_integer(), TypeParam::max());
+	EXPECT_EQ(Rns(TypeParam::min()).to_integer(), TypeParam::min());
+	EXPECT_EQ(Rns(TypeParam(Rns::moduli[0])).residue(0), 0u);
+	EXPECT_EQ(Rns(TypeParam(Rns::moduli[0]) + 7u).residue(0), 7u);
+	EXPECT_EQ(Rns(TypeParam(Rns::moduli[0]) + 7u).residue(1), Rns::moduli[0] - Rns::moduli[1] + 7u);
+
+	for(std::size_t i = 1; i < Rns::moduli.size(); i++)
+	{
+		EXPECT_LT(Rns::moduli[i], Rns::moduli[i-1]);
+		EXPECT_GT(Rns::moduli[i], uint64_t(1) << 61);
+	}
+
+	std::mt19937_64 engine(8);
+	for(int i = 0; i < 100; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		EXPECT_EQ(Rns(a).to_integer(), a);
+		EXPECT_EQ((-Rns(a)).to_integer(), -a);
+	}
+	EXPECT_EQ(Rns(TypeParam(5u)).residue(0), 5u);
+	if constexpr(std::is_signed_v<TypeParam>)
+	{
+		EXPECT_EQ(Rns(-TypeParam(5u)).residue(0), Rns::moduli[0] - 5u);
+		EXPECT_EQ((Rns(-TypeParam(5u)) * Rns(-TypeParam(7u))).to_integer(), 35u);
+	}
+}
+
+TYPED_TEST(BigIntegerTests, RnsArithmetic)
+{
+	using Rns = RnsInteger<TypeParam>;
+	std::mt19937_64 engine(9);
+	for(int i = 0; i < 50; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		const TypeParam b = random<TypeParam>(engine);
+		const TypeParam c = random<TypeParam>(engine);
+		EXPECT_EQ((Rns(a) + Rns(b)).to_integer(), a + b);
+		EXPECT_EQ((Rns(a) - Rns(b)).to_integer(), a - b);
+		EXPECT_EQ((Rns(a) * Rns(b)).to_integer(), a * b);
+		EXPECT_EQ((Rns(a) * Rns(b) + Rns(c)).to_integer(), a * b + c);
+		Rns x(a);
+		x *= Rns(b);
+		x -= Rns(c);
+		x += Rns(a);
+		EXPECT_EQ(x.to_integer(), a * b - c + a);
+		EXPECT_EQ(x - Rns(a), Rns(a) * Rns(b) - Rns(c));
+	}
+
+	/// exact double width product
+	if constexpr(std::is_unsigned_v<TypeParam> && TypeParam::bit_size <= 512)
+	{
+		using Double = BigInteger<uint64_t,false,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15>;
+		auto extend = [](const TypeParam & n) {
+			std::array<uint64_t,Double::word_count> words{};
+			const auto w = n.to_words();
+			std::copy(w.begin(), w.end(), words.begin());
+			return Double::from_words(words);
+		};
+		const TypeParam a = random<TypeParam>(engine);
+		const TypeParam b = random<TypeParam>(engine);
+		EXPECT_EQ((Rns(a) * Rns(b)).template to_integer<Double>(), extend(a) * extend(b));
+	}
+}
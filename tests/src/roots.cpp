@@ -0,0 +1,103 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+TYPED_TEST(BigIntegerTests, SquareRoot)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(isqrt(TypeParam(1000000u)) == TypeParam(1000u), "Square root failed");
+		static_assert(isqrt(TypeParam(999999u)) == TypeParam(999u), "Square root failed");
+	}
+
+	EXPECT_EQ(isqrt(TypeParam(0u)), 0u);
+	EXPECT_EQ(isqrt(TypeParam(1u)), 1u);
+	EXPECT_EQ(isqrt(TypeParam(3u)), 1u);
+	EXPECT_EQ(isqrt(TypeParam(4u)), 2u);
+
+	/// floor property r^2 <= n < (r+1)^2 for the whole range
+	TypeParam n = TypeParam::max();
+	for(std::size_t i = 0; i < TypeParam::bit_size; i += 7)
+	{
+		TypeParam r = isqrt(n);
+		TypeParam rest = n - r * r;
+		EXPECT_LE(rest, r + r);
+		n >>= 7u;
+	}
+
+	TypeParam x = TypeParam(1u) << (TypeParam::bit_size / 2 - 3);
+	x -= 12345u;
+	EXPECT_EQ(isqrt(x * x), x);
+	EXPECT_EQ(isqrt(x * x - 1u), x - 1u);
+	EXPECT_EQ(isqrt(x * x + x + x), x);
+
+	if constexpr(TypeParam(0u) > ~TypeParam(0u))
+	{
+		EXPECT_THROW(isqrt(-TypeParam(4u)), std::invalid_argument);
+	}
+}
+
+TYPED_TEST(BigIntegerTests, KthRoot)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(iroot(TypeParam(1000000u), 3u) == TypeParam(100u), "Root failed");
+		static_assert(iroot(TypeParam(999999u), 3u) == TypeParam(99u), "Root failed");
+	}
+
+	EXPECT_THROW(iroot(TypeParam(8u), 0u), std::invalid_argument);
+	EXPECT_EQ(iroot(TypeParam(8u), 1u), 8u);
+	EXPECT_EQ(iroot(TypeParam(7u), 3u), 1u);
+	EXPECT_EQ(iroot(TypeParam(8u), 3u), 2u);
+	EXPECT_EQ(iroot(TypeParam::max(), TypeParam::bit_size), 1u);
+	EXPECT_EQ(iroot(TypeParam::max(), TypeParam::bit_size / 2), 3u);
+	EXPECT_EQ(iroot(TypeParam::max(), 2u), isqrt(TypeParam::max()));
+
+	for(unsigned k = 3; k < 12; k++)
+	{
+		TypeParam x = (TypeParam(1u) << (TypeParam::bit_size / k - 1)) + 977u;
+		TypeParam p = TypeParam::exp(TypeParam(x), k);
+		EXPECT_EQ(iroot(p, k), x);
+		EXPECT_EQ(iroot(p - 1u, k), x - 1u);
+		EXPECT_EQ(iroot(p + 1u, k), x);
+	}
+}
+
+TYPED_TEST(BigIntegerTests, PerfectSquare)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(is_perfect_square(TypeParam(1024u)), "Perfect square failed");
+		static_assert(!is_perfect_square(TypeParam(1025u)), "Perfect square failed");
+	}
+
+	EXPECT_TRUE(is_perfect_square(TypeParam(0u)));
+	EXPECT_TRUE(is_perfect_square(TypeParam(1u)));
+	EXPECT_FALSE(is_perfect_square(TypeParam(2u)));
+	EXPECT_FALSE(is_perfect_square(TypeParam(17u)));
+
+	TypeParam x = (TypeParam(1u) << (TypeParam::bit_size / 2 - 2)) - 99u;
+	EXPECT_TRUE(is_perfect_square(x * x));
+	EXPECT_FALSE(is_perfect_square(x * x + 1u));
+	EXPECT_FALSE(is_perfect_square(x * x - 1u));
+}
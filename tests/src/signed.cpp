@@ -0,0 +1,120 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+template <typename T>
+class SignedTests : public ::testing::Test {
+};
+
+typedef Types<int192_t, int384_64_t, int512_t, int2048_t> SignedTypes;
+
+TYPED_TEST_SUITE(SignedTests, SignedTypes);
+
+TYPED_TEST(SignedTests, ArithmeticShift)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert((TypeParam(0u) - 8u) >> 2u == TypeParam(0u) - 2u, "Arithmetic shift failed");
+		static_assert((TypeParam(0u) - 7u) >> 1u == TypeParam(0u) - 4u, "Arithmetic shift failed");
+	}
+
+	const TypeParam minus_one = TypeParam(0u) - 1u;
+	EXPECT_EQ(minus_one >> 1u, minus_one);
+	EXPECT_EQ(TypeParam::min() >> (TypeParam::bit_size - 1), minus_one);
+	EXPECT_EQ(TypeParam::min() >> TypeParam::bit_size, minus_one);
+	EXPECT_EQ(TypeParam::max() >> (TypeParam::bit_size - 1), 0u);
+	EXPECT_EQ(TypeParam::max() >> TypeParam::bit_size, 0u);
+
+	std::mt19937_64 engine(37);
+	for(int i = 0; i < 50; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		const std::size_t n = engine() % (TypeParam::bit_size - 1);
+		const TypeParam power = TypeParam(1u) << n;
+		/// a minus its low bits is a multiple of 2^n, so the division is exact
+		EXPECT_EQ(a >> n, (a - (a & (power - 1u))) / power);
+		EXPECT_EQ((a >> n) < 0u, a < 0u);
+	}
+}
+
+TYPED_TEST(SignedTests, AbsSign)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(abs(TypeParam(0u) - 5u) == 5u, "Abs failed");
+		static_assert(sign(TypeParam(0u) - 5u) == -1, "Sign failed");
+	}
+
+	EXPECT_EQ(abs(TypeParam(5u)), 5u);
+	EXPECT_EQ(abs(TypeParam::max()), TypeParam::max());
+	EXPECT_EQ(abs(TypeParam::min() + 1u), TypeParam::max());
+	EXPECT_EQ(abs(TypeParam::min()), TypeParam::min());
+	EXPECT_EQ(sign(TypeParam(0u)), 0);
+	EXPECT_EQ(sign(TypeParam::max()), 1);
+	EXPECT_EQ(sign(TypeParam::min()), -1);
+	EXPECT_EQ(sign(uint256_t::max()), 1);
+	EXPECT_EQ(abs(uint256_t::max()), uint256_t::max());
+}
+
+TYPED_TEST(SignedTests, Divmod)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert((TypeParam(0u) - 7u) / TypeParam(2u) == TypeParam(0u) - 3u, "Signed division failed");
+		static_assert((TypeParam(0u) - 7u) % TypeParam(2u) == TypeParam(0u) - 1u, "Signed modulo failed");
+	}
+
+	/// same results as int64_t
+	const int64_t values[] = {7, -7, 2, -2, 1, -1, 100, -100, 3};
+	for(int64_t l : values)
+	{
+		for(int64_t r : values)
+		{
+			const auto [q, m] = TypeParam::divmod(TypeParam(l), TypeParam(r));
+			EXPECT_EQ(q, TypeParam(l / r));
+			EXPECT_EQ(m, TypeParam(l % r));
+		}
+	}
+	EXPECT_EQ(TypeParam::min() / (TypeParam(0u) - 1u), TypeParam::min());
+	EXPECT_EQ(TypeParam::min() / TypeParam::min(), 1u);
+	EXPECT_THROW(TypeParam(1u) / TypeParam(0u), std::invalid_argument);
+
+	std::mt19937_64 engine(38);
+	for(int i = 0; i < 50; i++)
+	{
+		const TypeParam l = random<TypeParam>(engine);
+		const TypeParam r = random<TypeParam>(engine) >> (engine() % (TypeParam::bit_size - 1));
+		if(r == 0u)
+		{
+			continue;
+		}
+		const auto [q, m] = TypeParam::divmod(l, r);
+		EXPECT_EQ(q * r + m, l);
+		EXPECT_LT(abs(m), abs(r));
+		EXPECT_TRUE(m == 0u || sign(m) == sign(l));
+		EXPECT_EQ(abs(q), abs(l) / abs(r));
+	}
+}
@@ -123,3 +123,10 @@ TYPED_TEST(BigIntegerTests, Subtract)
 	EXPECT_EQ(a1-b1, c1);
 	EXPECT_EQ(a2-b2, c2);
 }
+
+TYPED_TEST(BigIntegerTests, SubtractBorrowChain)
+{
+	/// borrow has to ripple through every block
+	TypeParam a = TypeParam(1u) << (TypeParam::bit_size - 8);
+	EXPECT_EQ(a - 1u, ~(~TypeParam(0u) << (TypeParam::bit_size - 8)));
+}
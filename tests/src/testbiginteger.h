@@ -18,6 +18,8 @@
 #include "gtest/gtest.h"
 
 #include "biginteger.h"
+#include "bigintegerio.h"
+#include "numbertheory.h"
 
 using namespace biginteger;
 using ::testing::Types;
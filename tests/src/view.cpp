@@ -0,0 +1,81 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+
+#include "testbiginteger.h"
+#include "bigintegerview.h"
+
+TYPED_TEST(BigIntegerTests, View)
+{
+	std::mt19937_64 engine(2020);
+	const TypeParam a = random<TypeParam>(engine);
+	const TypeParam b = random<TypeParam>(engine) | 1u;
+	constexpr std::size_t size = TypeParam::bit_size / 8;
+
+	/// unaligned little and big endian copies of a and b
+	std::vector<std::byte> buffer(4 * size + 1);
+	std::byte * base = buffer.data() + 1;
+	BigIntegerRef<TypeParam> la(base);
+	BigIntegerRef<TypeParam, std::endian::big> ba(base + size);
+	BigIntegerRef<TypeParam> lb(base + 2 * size);
+	BigIntegerRef<TypeParam, std::endian::big> bb(base + 3 * size);
+	la = a;
+	ba = a;
+	lb = b;
+	bb = b;
+
+	const auto words = a.to_words();
+	for(std::size_t i = 0; i < size; i++)
+	{
+		const auto byte = std::byte(words[i / 8] >> (8 * (i % 8)));
+		EXPECT_EQ(base[i], byte);
+		EXPECT_EQ(base[2 * size - 1 - i], byte);
+	}
+
+	EXPECT_EQ(la.load(), a);
+	EXPECT_EQ(ba.load(), a);
+	EXPECT_EQ((BigIntegerView<TypeParam, std::endian::big>(base + size).load()), a);
+	EXPECT_TRUE(la == ba);
+	EXPECT_EQ(la + bb, a + b);
+	EXPECT_EQ(ba * lb, a * b);
+	EXPECT_EQ(la / bb, a / b);
+	EXPECT_EQ(ba - 1u, a - 1u);
+	EXPECT_EQ(ba >> 5u, a >> 5u);
+	EXPECT_EQ(la < bb, a < b);
+	EXPECT_EQ(BigIntegerView<TypeParam>(base) ^ bb, a ^ b);
+
+	/// results are written in place
+	la += bb;
+	ba *= lb;
+	EXPECT_EQ(la.load(), a + b);
+	EXPECT_EQ(ba.load(), a * b);
+	ba <<= 3u;
+	EXPECT_EQ(ba.load(), (a * b) << 3u);
+	la %= lb;
+	EXPECT_EQ(la.load(), (a + b) % b);
+	++lb;
+	--bb;
+	EXPECT_EQ(lb.load(), b + 1u);
+	EXPECT_EQ(bb.load(), b - 1u);
+
+	/// assignment copies the value, the references stay where they are
+	la = bb;
+	EXPECT_EQ(la.load(), b - 1u);
+	EXPECT_EQ(la.address(), base);
+}
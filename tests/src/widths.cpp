@@ -0,0 +1,120 @@
+/*
+ * This file is part of the XXX distribution (https://github.com/xxxx).
+ * Copyright (c) 2020 Martin Schuler.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <random>
+
+#include "testbiginteger.h"
+
+static constexpr bool proof_const = true;
+
+template <typename T>
+class BigIntWidthTests : public ::testing::Test {
+};
+
+typedef Types<uint192_t, int192_t, uint384_t, int384_t, uint2048_t, int2048_t, uint4096_t, int4096_t> BigIntWidthTypes;
+
+TYPED_TEST_SUITE(BigIntWidthTests, BigIntWidthTypes);
+
+static_assert(std::is_same_v<BigInt<128>, uint128_t>, "BigInt 128 failed");
+static_assert(std::is_same_v<BigInt<256>, uint256_t>, "BigInt 256 failed");
+static_assert(std::is_same_v<BigInt<512>, uint512_t>, "BigInt 512 failed");
+static_assert(std::is_same_v<BigInt<512,true>, int512_t>, "BigInt signed 512 failed");
+static_assert(std::is_same_v<BigInt<1024>, uint1024_t>, "BigInt 1024 failed");
+static_assert(sizeof(uint192_t) == 24 && sizeof(uint384_t) == 48, "BigInt size failed");
+
+TYPED_TEST(BigIntWidthTests, Arithmetic)
+{
+	/// same width with 32 bit blocks as reference
+	using Reference = BigInt<TypeParam::bit_size, (TypeParam::min() < 0u), uint32_t>;
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(TypeParam(3u) * TypeParam(5u) + TypeParam(7u) == 22u, "BigInt arithmetic failed");
+		static_assert(TypeParam::template to_number<'0','x','f','f'>() == 255u, "BigInt literal failed");
+	}
+
+	EXPECT_EQ(TypeParam::max() + 1u, TypeParam::min());
+	EXPECT_EQ(popcount(~TypeParam(0u)), TypeParam::bit_size);
+
+	std::mt19937_64 engine(35);
+	for(int i = 0; i < 20; i++)
+	{
+		const TypeParam a = random<TypeParam>(engine);
+		const TypeParam b = random<TypeParam>(engine) >> (engine() % TypeParam::bit_size);
+		const Reference ra = Reference::from_words(a.to_words());
+		const Reference rb = Reference::from_words(b.to_words());
+		const std::size_t n = engine() % TypeParam::bit_size;
+		EXPECT_EQ((a + b).to_words(), (ra + rb).to_words());
+		EXPECT_EQ((a - b).to_words(), (ra - rb).to_words());
+		EXPECT_EQ((a * b).to_words(), (ra * rb).to_words());
+		EXPECT_EQ((a << n).to_words(), (ra << n).to_words());
+		EXPECT_EQ((a >> n).to_words(), (ra >> n).to_words());
+		EXPECT_EQ(a < b, ra < rb);
+		if(b != 0u)
+		{
+			EXPECT_EQ((a / b).to_words(), (ra / rb).to_words());
+			EXPECT_EQ((a % b).to_words(), (ra % rb).to_words());
+		}
+	}
+}
+
+TEST(BigIntWidthTests, Literals)
+{
+	{
+		using namespace uint192;
+		EXPECT_EQ(0xffffffffffffffffffffffffffffffffffffffffffffffff_num, uint192_t::max());
+	}
+	{
+		using namespace int384;
+		EXPECT_EQ(123456789012345678901234567890_num, int384_t(123456789012345678u) * 1000000000000u + 901234567890u);
+	}
+	{
+		using namespace uint4096;
+		EXPECT_EQ(0x10000000000000000_num, uint4096_t(1u) << 64u);
+	}
+}
+
+TEST(BigIntWidthTests, Layouts)
+{
+	if constexpr(proof_const)
+	{
+		/// Test compile time computing
+		static_assert(limb_cast<uint512_64_t>(uint512_t::max() - 5u) == uint512_64_t::max() - 5u, "Layout conversion failed");
+		static_assert(limb_cast<uint256_t>(uint256_64_t(1u) << 100u) == uint256_t(1u) << 100u, "Layout conversion failed");
+		static_assert(limb_cast<int512_t>(int512_64_t(0u) - 7u) == int512_t(0u) - 7u, "Layout conversion failed");
+	}
+	static_assert(sizeof(uint512_64_t) == sizeof(uint512_t), "Layout size failed");
+	static_assert(std::is_same_v<fast_limb_t<192, limb_operation::add>, uint64_t>, "Limb selection failed");
+	static_assert(std::is_same_v<FastBigInt<512, limb_operation::divide>,
+		std::conditional_t<detail::limb64_faster[1][2], uint512_64_t, uint512_t>>, "Limb selection failed");
+	static_assert(std::is_same_v<FastBigInt<640, limb_operation::add>,
+		std::conditional_t<detail::limb64_faster[1][0], BigInt<640,false,uint64_t>, BigInt<640>>>, "Limb selection failed");
+
+	std::mt19937_64 engine(36);
+	for(int i = 0; i < 50; i++)
+	{
+		const uint1024_t a = random<uint1024_t>(engine);
+		const uint1024_t b = random<uint1024_t>(engine) >> 300u;
+		const uint1024_64_t na = limb_cast<uint1024_64_t>(a);
+		const uint1024_64_t nb = limb_cast<uint1024_64_t>(b);
+		EXPECT_EQ(na.to_words(), a.to_words());
+		EXPECT_EQ(limb_cast<uint1024_t>(na), a);
+		EXPECT_EQ(limb_cast<uint1024_t>(na * nb + na / nb), a * b + a / b);
+		EXPECT_EQ(limb_cast<uint1024_t>(na >> 77u), a >> 77u);
+	}
+}